@@ -0,0 +1,73 @@
+#include "cbormapbuilder_p.h"
+
+#include <QtCore/QCborStreamWriter>
+using namespace QtJsonSerializer;
+
+void CborKeyIndex::reserve(qsizetype size)
+{
+	_strings.reserve(static_cast<int>(size));
+}
+
+qsizetype CborKeyIndex::add(const QCborValue &key, qsizetype position)
+{
+	// string keys are by far the most common ones, all others are compared by their encoding
+	if (key.isString()) {
+		const auto id = key.toString();
+		if (const auto it = _strings.constFind(id); it != _strings.constEnd())
+			return *it;
+		_strings.insert(id, position);
+	} else {
+		const auto id = key.toCbor();
+		if (const auto it = _others.constFind(id); it != _others.constEnd())
+			return *it;
+		_others.insert(id, position);
+	}
+	return position;
+}
+
+CborMapBuilder::CborMapBuilder(qsizetype reserve)
+{
+	if (reserve > 0) {
+		_entries.reserve(static_cast<int>(reserve));
+		_keys.reserve(reserve);
+	}
+}
+
+void CborMapBuilder::append(const QCborValue &key, const QCborValue &value)
+{
+	if (const auto index = _keys.add(key, _entries.size()); index != _entries.size())
+		_entries[static_cast<int>(index)].second = value;
+	else
+		_entries.append(std::make_pair(key, value));
+}
+
+QCborMap CborMapBuilder::take()
+{
+	QCborMap map;
+	if (_entries.size() <= InsertLimit) {
+		for (const auto &entry : qAsConst(_entries))
+			map.insert(entry.first, entry.second);
+	} else {
+		// keys are unique, so a map of the keys only can be encoded once and parsed as a whole, which
+		// is linear. The values are then assigned in place, without encoding or copying them
+		QByteArray data;
+		{
+			QCborStreamWriter writer{&data};
+			writer.startMap(_entries.size());
+			for (const auto &entry : qAsConst(_entries)) {
+				entry.first.toCbor(writer);
+				writer.append(nullptr);
+			}
+			writer.endMap();
+		}
+		map = QCborValue::fromCbor(data).toMap();
+		auto it = map.begin();
+		for (const auto &entry : qAsConst(_entries)) {
+			it.value() = entry.second;
+			++it;
+		}
+	}
+	_entries.clear();
+	_keys = {};
+	return map;
+}
@@ -0,0 +1,48 @@
+#ifndef QTJSONSERIALIZER_CBORMAPBUILDER_P_H
+#define QTJSONSERIALIZER_CBORMAPBUILDER_P_H
+
+#include "qtjsonserializer_global.h"
+
+#include <QtCore/QCborMap>
+#include <QtCore/QCborValue>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+namespace QtJsonSerializer {
+
+// finds equal serialized keys, as a map must contain every key only once
+class Q_JSONSERIALIZER_EXPORT CborKeyIndex
+{
+public:
+	void reserve(qsizetype size);
+	// returns the position the key was first added with, or position if it is new
+	qsizetype add(const QCborValue &key, qsizetype position);
+
+private:
+	QHash<QString, qsizetype> _strings;
+	QHash<QByteArray, qsizetype> _others;
+};
+
+// builds a QCborMap without the linear key lookup of QCborMap::insert for every entry. If a key is
+// appended twice, the last value replaces the first one in place, just like QCborMap::insert does
+class Q_JSONSERIALIZER_EXPORT CborMapBuilder
+{
+	Q_DISABLE_COPY(CborMapBuilder)
+
+public:
+	explicit CborMapBuilder(qsizetype reserve = 0);
+
+	void append(const QCborValue &key, const QCborValue &value);
+	QCborMap take();
+
+private:
+	// up to this size, inserting into the map is cheaper than encoding and parsing its keys
+	static constexpr qsizetype InsertLimit = 32;
+
+	QVector<std::pair<QCborValue, QCborValue>> _entries;
+	CborKeyIndex _keys;
+};
+
+}
+
+#endif // QTJSONSERIALIZER_CBORMAPBUILDER_P_H
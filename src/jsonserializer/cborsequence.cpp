@@ -0,0 +1,94 @@
+#include "cborsequence.h"
+#include "cborsequence_p.h"
+#include "valuereader_p.h"
+
+#include <QtCore/QCborStreamReader>
+using namespace QtJsonSerializer;
+
+CborSequenceWriter::CborSequenceWriter(const CborSerializer *serializer, QIODevice *device, QCborValue::EncodingOptions options) :
+	d{new CborSequenceWriterPrivate{serializer, serializer->d_func()->currentSettings(), device, options}}
+{
+	if (!device->isOpen() || !device->isWritable())
+		throw SerializationException{"QIODevice must be open and writable!"};
+}
+
+CborSequenceWriter::~CborSequenceWriter() = default;
+
+void CborSequenceWriter::write(const QVariant &record)
+{
+	// records are simply written one after the other, as top level items of the same stream
+	const SettingsScope settingsScope{d->serializer->d_func(), d->settings};
+	d->serializer->serializeVariantTo(record.userType(), record, d->writer);
+}
+
+
+
+CborSequenceReader::CborSequenceReader(const CborSerializer *serializer, QIODevice *device) :
+	d{new CborSequenceReaderPrivate{serializer, serializer->d_func()->currentSettings(), device}}
+{
+	if (!device->isOpen() || !device->isReadable())
+		throw DeserializationException{"QIODevice must be open and readable!"};
+}
+
+CborSequenceReader::~CborSequenceReader() = default;
+
+bool CborSequenceReader::hasNext() const
+{
+	return d->offset < d->buffer.size() || d->fill();
+}
+
+QVariant CborSequenceReader::read(int metaTypeId, QObject *parent)
+{
+	const auto size = d->nextRecordSize();
+	QCborStreamReader reader{QByteArray::fromRawData(d->buffer.constData() + d->offset, size)};
+	// the record is skipped even if it fails to deserialize, so the following records stay readable
+	d->offset += size;
+
+	CborValueReader valueReader{&reader};
+	const SettingsScope settingsScope{d->serializer->d_func(), d->settings};
+	return d->serializer->deserializeVariantFrom(metaTypeId, valueReader, parent);
+}
+
+// ------------- private implementation -------------
+
+CborSequenceWriterPrivate::CborSequenceWriterPrivate(const CborSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device, QCborValue::EncodingOptions options) :
+	serializer{serializer},
+	settings{std::move(settings)},
+	streamWriter{device},
+	writer{&streamWriter, options}
+{}
+
+CborSequenceReaderPrivate::CborSequenceReaderPrivate(const CborSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device) :
+	serializer{serializer},
+	settings{std::move(settings)},
+	device{device}
+{}
+
+bool CborSequenceReaderPrivate::fill(qint64 size)
+{
+	// drop everything that has been read already, before appending the next chunk
+	buffer.remove(0, offset);
+	offset = 0;
+	const auto chunk = device->read(size);
+	buffer.append(chunk);
+	return !chunk.isEmpty();
+}
+
+int CborSequenceReaderPrivate::nextRecordSize()
+{
+	if (offset >= buffer.size() && !fill())
+		throw DeserializationException{"No more records to read from the device"};
+
+	// find the end of the record first, so it is only deserialized once it is available completely
+	forever {
+		QCborStreamReader scanner{QByteArray::fromRawData(buffer.constData() + offset, buffer.size() - offset)};
+		scanner.next();
+		const auto error = scanner.lastError();
+		if (error.c == QCborError::NoError)
+			return static_cast<int>(scanner.currentOffset());
+		// the scan restarts at the beginning of the record, so the available data is at least doubled
+		// every time to keep large records from being scanned over and over again
+		else if (error.c != QCborError::EndOfFile || !fill(qMax<qint64>(ChunkSize, buffer.size() - offset)))
+			throw DeserializationException("Failed to read file as CBOR with error: " + error.toString().toUtf8());
+	}
+}
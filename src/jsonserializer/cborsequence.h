@@ -0,0 +1,74 @@
+#ifndef QTJSONSERIALIZER_CBORSEQUENCE_H
+#define QTJSONSERIALIZER_CBORSEQUENCE_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+#include "QtJsonSerializer/cborserializer.h"
+
+#include <QtCore/qscopedpointer.h>
+
+namespace QtJsonSerializer {
+
+class CborSequenceWriterPrivate;
+//! Writes independent records to a device as CBOR sequence (RFC 8742), without any framing
+class Q_JSONSERIALIZER_EXPORT CborSequenceWriter
+{
+	Q_DISABLE_COPY(CborSequenceWriter)
+
+public:
+	//! Constructor, with the serializer to use, the device to write to and the options for all records
+	CborSequenceWriter(const CborSerializer *serializer, QIODevice *device, QCborValue::EncodingOptions options = QCborValue::NoTransformation);
+	~CborSequenceWriter();
+
+	//! Serializes a QVariant value as the next record
+	void write(const QVariant &record);
+	//! Serializes a generic c++ type as the next record
+	template <typename T>
+	void write(const T &record);
+
+private:
+	QScopedPointer<CborSequenceWriterPrivate> d;
+};
+
+class CborSequenceReaderPrivate;
+//! Reads independent records from a device with a CBOR sequence (RFC 8742), one record at a time
+class Q_JSONSERIALIZER_EXPORT CborSequenceReader
+{
+	Q_DISABLE_COPY(CborSequenceReader)
+
+public:
+	//! Constructor, with the serializer to use and the device to read from
+	CborSequenceReader(const CborSerializer *serializer, QIODevice *device);
+	~CborSequenceReader();
+
+	//! Checks if there are more records to be read
+	bool hasNext() const;
+
+	//! Deserializes the next record to a QVariant value, based on the given type id
+	QVariant read(int metaTypeId, QObject *parent = nullptr);
+	//! Deserializes the next record to the given c++ type
+	template <typename T>
+	T read(QObject *parent = nullptr);
+
+private:
+	QScopedPointer<CborSequenceReaderPrivate> d;
+};
+
+// ------------- Generic Implementation -------------
+
+template<typename T>
+void CborSequenceWriter::write(const T &record)
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be serialized");
+	write(__private::variant_helper<T>::toVariant(record));
+}
+
+template<typename T>
+T CborSequenceReader::read(QObject *parent)
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	return __private::variant_helper<T>::fromVariant(read(qMetaTypeId<T>(), parent));
+}
+
+}
+
+#endif // QTJSONSERIALIZER_CBORSEQUENCE_H
@@ -0,0 +1,45 @@
+#ifndef QTJSONSERIALIZER_CBORSEQUENCE_P_H
+#define QTJSONSERIALIZER_CBORSEQUENCE_P_H
+
+#include "cborsequence.h"
+#include "cborserializer_p.h"
+#include "valuewriter_p.h"
+
+#include <QtCore/QCborStreamWriter>
+
+namespace QtJsonSerializer {
+
+class CborSequenceWriterPrivate
+{
+public:
+	CborSequenceWriterPrivate(const CborSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device, QCborValue::EncodingOptions options);
+
+	const CborSerializer *serializer;
+	// all records are written with the settings of the time the writer was created
+	QSharedPointer<const SerializerSettings> settings;
+	QCborStreamWriter streamWriter;
+	CborValueWriter writer;
+};
+
+class CborSequenceReaderPrivate
+{
+public:
+	// the device is read in chunks of this size, so the sequence never has to be in memory completely
+	static constexpr qint64 ChunkSize = 16 * 1024;
+
+	CborSequenceReaderPrivate(const CborSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device);
+
+	const CborSerializer *serializer;
+	// all records are read with the settings of the time the reader was created
+	QSharedPointer<const SerializerSettings> settings;
+	QIODevice *device;
+	QByteArray buffer;
+	int offset = 0;
+
+	bool fill(qint64 size = ChunkSize);
+	int nextRecordSize();
+};
+
+}
+
+#endif // QTJSONSERIALIZER_CBORSEQUENCE_P_H
@@ -1,11 +1,16 @@
 #include "cborserializer.h"
 #include "cborserializer_p.h"
+#include "valuewriter_p.h"
+#include "valuereader_p.h"
 
 #include <cmath>
+#include <limits>
 
 #include <QtCore/QCborStreamReader>
 #include <QtCore/QCborStreamWriter>
+#include <QtCore/QFile>
 #include <QtCore/QtEndian>
+#include <QtCore/QScopeGuard>
 using namespace QtJsonSerializer;
 
 Q_LOGGING_CATEGORY(QtJsonSerializer::logCbor, "qt.jsonserializer.serializer.cbor")
@@ -26,6 +31,12 @@ bool CborSerializer::handleSpecialNumbers() const
 	return d->handleSpecialNumbers;
 }
 
+bool CborSerializer::typedArrays() const
+{
+	Q_D(const CborSerializer);
+	return d->typedArrays;
+}
+
 void CborSerializer::setTypeTag(int metaTypeId, QCborTag tag)
 {
 	Q_D(CborSerializer);
@@ -39,13 +50,21 @@ void CborSerializer::setTypeTag(int metaTypeId, QCborTag tag)
 		d->typeTags.insert(metaTypeId, tag);
 		qCDebug(logCbor) << "Removed Type-Tag for metaTypeId" << QMetaType::typeName(metaTypeId);
 	}
+	lock.unlock();
+	d->invalidateSettings();
 }
 
 QCborTag CborSerializer::typeTag(int metaTypeId) const
 {
 	Q_D(const CborSerializer);
-	QReadLocker lock{&d->typeTagsLock};
-	const auto tag = d->typeTags.value(metaTypeId, TypeConverter::NoTag);
+	// within a de/serialization, the tags are read from the captured settings
+	QCborTag tag;
+	if (const auto settings = d->activeSettings(); settings)
+		tag = settings->typeTags.value(metaTypeId, TypeConverter::NoTag);
+	else {
+		QReadLocker lock{&d->typeTagsLock};
+		tag = d->typeTags.value(metaTypeId, TypeConverter::NoTag);
+	}
 	if (tag != TypeConverter::NoTag) {
 		qCDebug(logCbor) << "Found Type-Tag for metaTypeId" << QMetaType::typeName(metaTypeId)
 						 << "as" << tag;
@@ -63,13 +82,28 @@ void CborSerializer::serializeTo(QIODevice *device, const QVariant &data, QCborV
 {
 	if (!device->isOpen() || !device->isWritable())
 		throw SerializationException{"QIODevice must be open and writable!"};
+	// converters write into the stream directly, so no CBOR tree of the whole document is built
 	QCborStreamWriter writer{device};
-	serializeVariant(data.userType(), data).toCbor(writer, options);
+	CborValueWriter valueWriter{&writer, options};
+	serializeVariantTo(data.userType(), data, valueWriter);
 }
 
 QByteArray CborSerializer::serializeTo(const QVariant &data, QCborValue::EncodingOptions options) const
 {
-	return serializeVariant(data.userType(), data).toCbor(options);
+	QByteArray result;
+	QCborStreamWriter writer{&result};
+	CborValueWriter valueWriter{&writer, options};
+	serializeVariantTo(data.userType(), data, valueWriter);
+	return result;
+}
+
+void CborSerializer::serializeSequenceTo(QIODevice *device, int elementType, const SequenceGenerator &generator, QCborValue::EncodingOptions options) const
+{
+	if (!device->isOpen() || !device->isWritable())
+		throw SerializationException{"QIODevice must be open and writable!"};
+	QCborStreamWriter writer{device};
+	CborValueWriter valueWriter{&writer, options};
+	serializeSequenceVariantTo(elementType, generator, valueWriter);
 }
 
 QVariant CborSerializer::deserialize(const QCborValue &cbor, int metaTypeId, QObject *parent) const
@@ -77,24 +111,72 @@ QVariant CborSerializer::deserialize(const QCborValue &cbor, int metaTypeId, QOb
 	return deserializeVariant(metaTypeId, cbor, parent);
 }
 
+void CborSerializer::deserializeInto(const QCborValue &cbor, int metaTypeId, void *data, QObject *parent) const
+{
+	deserializeData(metaTypeId, cbor, data, parent);
+}
+
 QVariant CborSerializer::deserializeFrom(QIODevice *device, int metaTypeId, QObject *parent) const
 {
 	if (!device->isOpen() || !device->isReadable())
 		throw DeserializationException{"QIODevice must be open and readable!"};
+	// converters read from the stream directly, so no CBOR tree of the whole document is built
 	QCborStreamReader reader{device};
-	const auto cbor = QCborValue::fromCbor(reader);
-	if (const auto error = reader.lastError(); error.c != QCborError::NoError)
-		throw DeserializationException("Failed to read file as CBOR with error: " + error.toString().toUtf8());
-	return deserializeVariant(metaTypeId, cbor, parent);
+	CborValueReader valueReader{&reader};
+	return deserializeVariantFrom(metaTypeId, valueReader, parent);
 }
 
 QVariant CborSerializer::deserializeFrom(const QByteArray &data, int metaTypeId, QObject *parent) const
 {
-	QCborParserError error;
-	const auto cbor = QCborValue::fromCbor(data, &error);
-	if (error.error.c != QCborError::NoError)
-		throw DeserializationException("Failed to read file as CBOR with error: " + error.error.toString().toUtf8());
-	return deserializeVariant(metaTypeId, cbor, parent);
+	QCborStreamReader reader{data};
+	CborValueReader valueReader{&reader};
+	return deserializeVariantFrom(metaTypeId, valueReader, parent);
+}
+
+QVariant CborSerializer::deserializeAt(QIODevice *device, const QString &pointer, int metaTypeId, QObject *parent) const
+{
+	if (!device->isOpen() || !device->isReadable())
+		throw DeserializationException{"QIODevice must be open and readable!"};
+	// reading stops after the target value, so the rest of the document is neither read nor validated
+	QCborStreamReader reader{device};
+	CborValueReader valueReader{&reader};
+	return deserializeVariantAt(metaTypeId, pointer, valueReader, parent);
+}
+
+QVariant CborSerializer::deserializeAt(const QByteArray &data, const QString &pointer, int metaTypeId, QObject *parent) const
+{
+	QCborStreamReader reader{data};
+	CborValueReader valueReader{&reader};
+	return deserializeVariantAt(metaTypeId, pointer, valueReader, parent);
+}
+
+QVariant CborSerializer::deserializeMapped(QFile *file, int metaTypeId, QObject *parent) const
+{
+	if (!file->isOpen() || !file->isReadable())
+		throw DeserializationException{"QIODevice must be open and readable!"};
+
+	// byte arrays are limited to 2 GiB, so larger files are read like any other device
+	const auto pos = file->pos();
+	const auto size = file->size() - pos;
+	uchar *data = nullptr;
+	if (size > 0 && size <= std::numeric_limits<int>::max())
+		data = file->map(pos, size);
+	if (!data)
+		return deserializeFrom(file, metaTypeId, parent);
+
+	const auto rawData = QByteArray::fromRawData(reinterpret_cast<const char*>(data), static_cast<int>(size));
+	QCborStreamReader reader{rawData};
+	CborValueReader valueReader{&reader};
+	valueReader.setRawData(rawData);
+	// byte arrays of the result reference the mapping, so it is only removed if none were read
+	const auto unmapGuard = qScopeGuard([&]() {
+		if (!valueReader.isRawDataReferenced())
+			file->unmap(data);
+	});
+	auto result = deserializeVariantFrom(metaTypeId, valueReader, parent);
+	// just like reading from the device, the value is consumed
+	file->seek(pos + reader.currentOffset());
+	return result;
 }
 
 std::variant<QCborValue, QJsonValue> CborSerializer::serializeGeneric(const QVariant &value) const
@@ -117,6 +199,17 @@ void CborSerializer::setHandleSpecialNumbers(bool handleSpecialNumbers)
 	emit handleSpecialNumbersChanged(d->handleSpecialNumbers, {});
 }
 
+void CborSerializer::setTypedArrays(bool typedArrays)
+{
+	Q_D(CborSerializer);
+	if(d->typedArrays == typedArrays)
+		return;
+
+	d->typedArrays = typedArrays;
+	d->invalidateSettings();
+	emit typedArraysChanged(d->typedArrays, {});
+}
+
 bool CborSerializer::jsonMode() const
 {
 	return false;
@@ -155,6 +248,14 @@ TInt extract(QByteArray data) {
 
 }
 
+void CborSerializerPrivate::fillSettings(SerializerSettings &settings) const
+{
+	SerializerBasePrivate::fillSettings(settings);
+	settings.typedArrays = typedArrays;
+	QReadLocker lock{&typeTagsLock};
+	settings.typeTags = typeTags;
+}
+
 QVariant CborSerializerPrivate::deserializeCborValue(int propertyType, const QCborValue &value) const
 {
 	if (handleSpecialNumbers) {
@@ -4,6 +4,10 @@
 #include "QtJsonSerializer/qtjsonserializer_global.h"
 #include "QtJsonSerializer/serializerbase.h"
 
+QT_BEGIN_NAMESPACE
+class QFile;
+QT_END_NAMESPACE
+
 namespace QtJsonSerializer {
 
 class CborSerializerPrivate;
@@ -14,6 +18,8 @@ class Q_JSONSERIALIZER_EXPORT CborSerializer : public SerializerBase
 
 	//! If enabled, specially tagged number types will be automatically deserialized to their type
 	Q_PROPERTY(bool handleSpecialNumbers READ handleSpecialNumbers WRITE setHandleSpecialNumbers NOTIFY handleSpecialNumbersChanged)
+	//! If enabled, numeric lists are serialized as RFC 8746 typed arrays
+	Q_PROPERTY(bool typedArrays READ typedArrays WRITE setTypedArrays NOTIFY typedArraysChanged)
 
 public:
 	//! Additional official CBOR-Tags, taken from https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
@@ -68,6 +74,8 @@ public:
 
 	//! @readAcFn{CborSerializer::handleSpecialNumbers}
 	bool handleSpecialNumbers() const;
+	//! @readAcFn{CborSerializer::typedArrays}
+	bool typedArrays() const;
 
 	//! Set a tag to always be used when serializing the given type
 	template <typename T>
@@ -85,6 +93,8 @@ public:
 	void serializeTo(QIODevice *device, const QVariant &data, QCborValue::EncodingOptions options = QCborValue::NoTransformation) const;
 	//! Serializers a QVariant value to a byte array
 	QByteArray serializeTo(const QVariant &data, QCborValue::EncodingOptions options = QCborValue::NoTransformation) const;
+	//! Serializers all values yielded by a generator as one indefinite length CBOR array to a device
+	void serializeSequenceTo(QIODevice *device, int elementType, const SequenceGenerator &generator, QCborValue::EncodingOptions options = QCborValue::NoTransformation) const;
 
 	//! Serializers a c++ type to cbor
 	template <typename T>
@@ -95,23 +105,49 @@ public:
 	//! Serializers a c++ type to a byte array
 	template <typename T>
 	QByteArray serializeTo(const T &data, QCborValue::EncodingOptions options = QCborValue::NoTransformation) const;
+	//! Serializers all c++ values yielded by a generator as one indefinite length CBOR array to a device
+	template <typename T, typename TGenerator>
+	void serializeSequenceTo(QIODevice *device, TGenerator &&generator, QCborValue::EncodingOptions options = QCborValue::NoTransformation) const;
+	//! Serializers all c++ values of an iterator range as one indefinite length CBOR array to a device
+	template <typename TIterator>
+	void serializeSequenceTo(QIODevice *device, TIterator begin, TIterator end, QCborValue::EncodingOptions options = QCborValue::NoTransformation) const;
 
 	//! Deserializes a QCborValue to a QVariant value, based on the given type id
 	QVariant deserialize(const QCborValue &cbor, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes a QCborValue into existing data of the given type id
+	void deserializeInto(const QCborValue &cbor, int metaTypeId, void *data, QObject *parent = nullptr) const;
 	//! Deserializes data from a device to a QVariant value, based on the given type id
 	QVariant deserializeFrom(QIODevice *device, int metaTypeId, QObject *parent = nullptr) const;
 	//! Deserializes data from a device to a QVariant value, based on the given type id
 	QVariant deserializeFrom(const QByteArray &data, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a device to a QVariant value, based on the given type id
+	QVariant deserializeAt(QIODevice *device, const QString &pointer, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a byte array to a QVariant value, based on the given type id
+	QVariant deserializeAt(const QByteArray &data, const QString &pointer, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes a complete file via a memory mapping, which byte arrays of the result reference, to a QVariant value
+	QVariant deserializeMapped(QFile *file, int metaTypeId, QObject *parent = nullptr) const;
 
 	//! Deserializes cbor to the given c++ type
 	template <typename T>
 	T deserialize(const QCborValue &cbor, QObject *parent = nullptr) const;
+	//! Deserializes cbor into existing data of the given c++ type
+	template <typename T>
+	void deserializeInto(const QCborValue &cbor, T &data, QObject *parent = nullptr) const;
 	//! Deserializes data from a device to the given c++ type
 	template <typename T>
 	T deserializeFrom(QIODevice *device, QObject *parent = nullptr) const;
 	//! Deserializes data from a byte array to the given c++ type
 	template <typename T>
 	T deserializeFrom(const QByteArray &data, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a device to the given c++ type
+	template <typename T>
+	T deserializeAt(QIODevice *device, const QString &pointer, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a byte array to the given c++ type
+	template <typename T>
+	T deserializeAt(const QByteArray &data, const QString &pointer, QObject *parent = nullptr) const;
+	//! Deserializes a complete file via a memory mapping, which byte arrays of the result reference, to the given c++ type
+	template <typename T>
+	T deserializeMapped(QFile *file, QObject *parent = nullptr) const;
 
 	std::variant<QCborValue, QJsonValue> serializeGeneric(const QVariant &value) const override;
 	QVariant deserializeGeneric(const std::variant<QCborValue, QJsonValue> &value, int metaTypeId, QObject *parent) const override;
@@ -119,10 +155,14 @@ public:
 public Q_SLOTS:
 	//! @writeAcFn{CborSerializer::handleSpecialNumbers}
 	void setHandleSpecialNumbers(bool handleSpecialNumbers);
+	//! @writeAcFn{CborSerializer::typedArrays}
+	void setTypedArrays(bool typedArrays);
 
 Q_SIGNALS:
 	//! @notifyAcFn{CborSerializer::handleSpecialNumbers}
 	void handleSpecialNumbersChanged(bool handleSpecialNumbers, QPrivateSignal);
+	//! @notifyAcFn{CborSerializer::typedArrays}
+	void typedArraysChanged(bool typedArrays, QPrivateSignal);
 
 protected:
 	// protected implementation -> internal use for the type converters
@@ -131,6 +171,8 @@ protected:
 
 private:
 	Q_DECLARE_PRIVATE(CborSerializer)
+	friend class CborSequenceWriter;
+	friend class CborSequenceReader;
 };
 
 // ------------- generic implementation -------------
@@ -151,6 +193,11 @@ template<typename T>
 QCborValue CborSerializer::serialize(const T &data) const
 {
 	static_assert(__private::is_serializable<T>::value, "T cannot be serialized");
+	if constexpr (__private::static_helper<T>::value) {
+		if (hasStaticPath(qMetaTypeId<T>()))
+			return __private::static_helper<T>::serialize(data);
+	} else if constexpr (__private::gadget_helper<T>::value)
+		return serializeData(qMetaTypeId<T>(), &data);
 	return serialize(__private::variant_helper<T>::toVariant(data));
 }
 
@@ -168,13 +215,50 @@ QByteArray CborSerializer::serializeTo(const T &data, QCborValue::EncodingOption
 	return serializeTo(__private::variant_helper<T>::toVariant(data), options);
 }
 
+template<typename T, typename TGenerator>
+void CborSerializer::serializeSequenceTo(QIODevice *device, TGenerator &&generator, QCborValue::EncodingOptions options) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be serialized");
+	serializeSequenceTo(device, qMetaTypeId<T>(), [&]() -> std::optional<QVariant> {
+		if (auto element = generator(); element)
+			return __private::variant_helper<T>::toVariant(*element);
+		else
+			return std::nullopt;
+	}, options);
+}
+
+template<typename TIterator>
+void CborSerializer::serializeSequenceTo(QIODevice *device, TIterator begin, TIterator end, QCborValue::EncodingOptions options) const
+{
+	using T = std::decay_t<typename std::iterator_traits<TIterator>::value_type>;
+	serializeSequenceTo<T>(device, [&]() -> std::optional<T> {
+		if (begin != end)
+			return *begin++;
+		else
+			return std::nullopt;
+	}, options);
+}
+
 template<typename T>
 T CborSerializer::deserialize(const QCborValue &cbor, QObject *parent) const
 {
 	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	if constexpr (__private::static_helper<T>::value) {
+		if (hasStaticPath(qMetaTypeId<T>())) {
+			if (auto data = __private::static_helper<T>::deserialize(cbor); data)
+				return std::move(*data);
+		}
+	}
 	return __private::variant_helper<T>::fromVariant(deserialize(cbor, qMetaTypeId<T>(), parent));
 }
 
+template<typename T>
+void CborSerializer::deserializeInto(const QCborValue &cbor, T &data, QObject *parent) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	deserializeInto(cbor, qMetaTypeId<T>(), &data, parent);
+}
+
 template<typename T>
 T CborSerializer::deserializeFrom(QIODevice *device, QObject *parent) const
 {
@@ -189,6 +273,27 @@ T CborSerializer::deserializeFrom(const QByteArray &data, QObject *parent) const
 	return __private::variant_helper<T>::fromVariant(deserializeFrom(data, qMetaTypeId<T>(), parent));
 }
 
+template<typename T>
+T CborSerializer::deserializeMapped(QFile *file, QObject *parent) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	return __private::variant_helper<T>::fromVariant(deserializeMapped(file, qMetaTypeId<T>(), parent));
+}
+
+template<typename T>
+T CborSerializer::deserializeAt(QIODevice *device, const QString &pointer, QObject *parent) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	return __private::variant_helper<T>::fromVariant(deserializeAt(device, pointer, qMetaTypeId<T>(), parent));
+}
+
+template<typename T>
+T CborSerializer::deserializeAt(const QByteArray &data, const QString &pointer, QObject *parent) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	return __private::variant_helper<T>::fromVariant(deserializeAt(data, pointer, qMetaTypeId<T>(), parent));
+}
+
 }
 
 #endif // QTJSONSERIALIZER_CBORSERIALIZER_H
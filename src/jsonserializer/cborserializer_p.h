@@ -22,7 +22,9 @@ public:
 	mutable QReadWriteLock typeTagsLock {};
 	QHash<int, QCborTag> typeTags {};
 	bool handleSpecialNumbers = false;
+	bool typedArrays = false;
 
+	void fillSettings(SerializerSettings &settings) const override;
 	QVariant deserializeCborValue(int propertyType, const QCborValue &value) const override;
 
 	QVariant deserializePositiveBignum(const QByteArray &data) const;
@@ -1,43 +1,170 @@
 #include "exceptioncontext_p.h"
+
+#include <vector>
 using namespace QtJsonSerializer;
 
 Q_LOGGING_CATEGORY(QtJsonSerializer::logExceptCtx, "qt.jsonserializer.private.exceptioncontext")
 
-QThreadStorage<SerializationException::PropertyTrace> ExceptionContext::contextStore;
+namespace {
+
+struct Frame {
+	enum Kind : quint8 {
+		Property,
+		Hint,
+		IndexElement,
+		VariantElement,
+		CborElement
+	};
+
+	Kind kind;
+	QMetaProperty property {};
+	int propertyType = QMetaType::UnknownType;
+	const QByteArray *hint = nullptr;
+	const QVariant *variantKey = nullptr;
+	const QCborValue *cborKey = nullptr;
+	const char *suffix = nullptr;
+	qint64 index = -1;
+
+	QByteArray elementName() const;
+};
+
+// only references are stored, so entering and leaving a context never allocates once the stack has grown
+thread_local std::vector<Frame> contextStack;
+thread_local int contextDepth = 0;
+
+QByteArray Frame::elementName() const
+{
+	QByteArray name;
+	switch (kind) {
+	case IndexElement:
+		return "[" + QByteArray::number(index) + "]";
+	case VariantElement:
+		name = "[" + variantKey->toString().toUtf8() + "]";
+		break;
+	case CborElement:
+		name = "[" + cborKey->toVariant().toString().toUtf8() + "]";
+		break;
+	default:
+		Q_UNREACHABLE();
+		break;
+	}
+	if (suffix)
+		name += suffix;
+	if (index != -1)
+		name += "[" + QByteArray::number(index) + "]";
+	return name;
+}
+
+void popFrame()
+{
+	if (contextStack.empty())
+		qCWarning(logExceptCtx) << "Corrupted context store";
+	else
+		contextStack.pop_back();
+}
+
+}
 
 ExceptionContext::ExceptionContext(const QMetaProperty &property)
 {
-	contextStore.localData().push({
-									  property.name(),
-									  property.isEnumType() ?
-										 property.enumerator().name() :
-										 property.typeName()
-								  });
+	Frame frame {Frame::Property};
+	frame.property = property;
+	contextStack.push_back(frame);
+	++contextDepth;
 }
 
 ExceptionContext::ExceptionContext(int propertyType, const QByteArray &hint)
 {
-	contextStore.localData().push({
-									  hint.isNull() ? QByteArray("<unnamed>") : hint,
-									  QMetaType::typeName(propertyType)
-								  });
+	Frame frame {Frame::Hint};
+	frame.propertyType = propertyType;
+	frame.hint = &hint;
+	contextStack.push_back(frame);
+	++contextDepth;
 }
 
 ExceptionContext::~ExceptionContext()
 {
-	auto &context = contextStore.localData();
-	if (context.isEmpty())
-		qCWarning(logExceptCtx) << "Corrupted context store";
-	else
-		context.pop();
+	popFrame();
+	--contextDepth;
 }
 
 SerializationException::PropertyTrace ExceptionContext::currentContext()
 {
-	return contextStore.localData();
+	SerializationException::PropertyTrace trace;
+	const Frame *element = nullptr;
+	for (const auto &frame : contextStack) {
+		switch (frame.kind) {
+		case Frame::Property:
+			trace.push({
+						   frame.property.name(),
+						   frame.property.isEnumType() ?
+							  frame.property.enumerator().name() :
+							  frame.property.typeName()
+					   });
+			break;
+		case Frame::Hint:
+			if (!frame.hint->isNull())
+				trace.push({*frame.hint, QMetaType::typeName(frame.propertyType)});
+			else if (element)
+				trace.push({element->elementName(), QMetaType::typeName(frame.propertyType)});
+			else
+				trace.push({QByteArray("<unnamed>"), QMetaType::typeName(frame.propertyType)});
+			break;
+		default:
+			element = &frame;
+			continue;
+		}
+		element = nullptr;
+	}
+	return trace;
 }
 
 int ExceptionContext::currentDepth()
 {
-	return contextStore.localData().size();
+	return contextDepth;
+}
+
+
+
+ExceptionContext::Element::Element(qint64 index) :
+	_frame{contextStack.size()}
+{
+	Frame frame {Frame::IndexElement};
+	frame.index = index;
+	contextStack.push_back(frame);
+}
+
+ExceptionContext::Element::Element(const QVariant &key, const char *suffix) :
+	_frame{contextStack.size()}
+{
+	Frame frame {Frame::VariantElement};
+	frame.variantKey = &key;
+	frame.suffix = suffix;
+	contextStack.push_back(frame);
+}
+
+ExceptionContext::Element::Element(const QCborValue &key, const char *suffix) :
+	_frame{contextStack.size()}
+{
+	Frame frame {Frame::CborElement};
+	frame.cborKey = &key;
+	frame.suffix = suffix;
+	contextStack.push_back(frame);
+}
+
+ExceptionContext::Element::~Element()
+{
+	popFrame();
+}
+
+void ExceptionContext::Element::setIndex(qint64 index)
+{
+	contextStack[_frame].index = index;
+}
+
+void ExceptionContext::Element::setSuffix(const char *suffix, qint64 subIndex)
+{
+	auto &frame = contextStack[_frame];
+	frame.suffix = suffix;
+	frame.index = subIndex;
 }
@@ -5,23 +5,41 @@
 #include "exception.h"
 
 #include <QtCore/QMetaProperty>
-#include <QtCore/QThreadStorage>
+#include <QtCore/QCborValue>
 #include <QtCore/QLoggingCategory>
 
 namespace QtJsonSerializer {
 
 class Q_JSONSERIALIZER_EXPORT ExceptionContext
 {
+	Q_DISABLE_COPY(ExceptionContext)
+
 public:
+	// Names the next unnamed context by a container element. Only references are stored,
+	// the name is generated when an exception actually needs the trace
+	class Q_JSONSERIALIZER_EXPORT Element
+	{
+		Q_DISABLE_COPY(Element)
+
+	public:
+		explicit Element(qint64 index);
+		Element(const QVariant &key, const char *suffix);
+		Element(const QCborValue &key, const char *suffix);
+		~Element();
+
+		void setIndex(qint64 index);
+		void setSuffix(const char *suffix, qint64 subIndex = -1);
+
+	private:
+		std::size_t _frame;
+	};
+
 	ExceptionContext(const QMetaProperty &property);
 	ExceptionContext(int propertyType, const QByteArray &hint);
 	~ExceptionContext();
 
 	static SerializationException::PropertyTrace currentContext();
 	static int currentDepth();
-
-private:
-	static QThreadStorage<SerializationException::PropertyTrace> contextStore;
 };
 
 Q_DECLARE_LOGGING_CATEGORY(logExceptCtx)
@@ -0,0 +1,288 @@
+#include "incrementaldeserializer.h"
+#include "incrementaldeserializer_p.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QtEndian>
+using namespace QtJsonSerializer;
+
+IncrementalDeserializer::IncrementalDeserializer(const SerializerBase *serializer, int metaTypeId, QObject *parent) :
+	QObject{*new IncrementalDeserializerPrivate{serializer, metaTypeId}, parent}
+{
+	Q_D(IncrementalDeserializer);
+	Q_ASSERT_X(d->jsonSerializer || d->cborSerializer, Q_FUNC_INFO, "serializer must be a JsonSerializer or a CborSerializer");
+}
+
+bool IncrementalDeserializer::hasPendingData() const
+{
+	Q_D(const IncrementalDeserializer);
+	return d->offset < d->buffer.size();
+}
+
+bool IncrementalDeserializer::hasFailed() const
+{
+	Q_D(const IncrementalDeserializer);
+	return d->failed;
+}
+
+QObject *IncrementalDeserializer::valueParent() const
+{
+	Q_D(const IncrementalDeserializer);
+	return d->valueParent;
+}
+
+void IncrementalDeserializer::setValueParent(QObject *valueParent)
+{
+	Q_D(IncrementalDeserializer);
+	d->valueParent = valueParent;
+}
+
+void IncrementalDeserializer::addData(const QByteArray &data)
+{
+	Q_D(IncrementalDeserializer);
+	if (d->failed)
+		return;
+
+	// drop all completed values, before appending the new chunk
+	d->buffer.remove(0, d->offset);
+	d->scanPos -= d->offset;
+	d->offset = 0;
+	d->buffer.append(data);
+
+	// typically called from slots, so errors are reported as signal instead of being thrown
+	forever {
+		std::optional<int> end;
+		try {
+			end = d->jsonSerializer ? d->scanJson() : d->scanCbor();
+		} catch (Exception &e) {
+			// the position of the next value is unknown, so everything is discarded
+			d->reset();
+			d->failed = true;
+			emit errorOccurred(QString::fromUtf8(e.what()));
+			return;
+		}
+		if (!end)
+			break;
+
+		// the value is consumed even if it fails to deserialize, so the following values stay readable
+		const auto message = QByteArray::fromRawData(d->buffer.constData() + d->offset, *end - d->offset);
+		d->offset = *end;
+		QVariant value;
+		try {
+			value = d->deserialize(message);
+		} catch (Exception &e) {
+			emit errorOccurred(QString::fromUtf8(e.what()));
+			continue;
+		}
+		emit valueDeserialized(value);
+	}
+}
+
+void IncrementalDeserializer::clear()
+{
+	Q_D(IncrementalDeserializer);
+	d->reset();
+	d->failed = false;
+}
+
+// ------------- private implementation -------------
+
+IncrementalDeserializerPrivate::IncrementalDeserializerPrivate(const SerializerBase *serializer, int metaTypeId) :
+	jsonSerializer{qobject_cast<const JsonSerializer*>(serializer)},
+	cborSerializer{qobject_cast<const CborSerializer*>(serializer)},
+	metaTypeId{metaTypeId}
+{}
+
+void IncrementalDeserializerPrivate::reset()
+{
+	buffer.clear();
+	offset = 0;
+	scanPos = 0;
+	depth = 0;
+	inString = false;
+	escaped = false;
+	frames.clear();
+	skip = 0;
+}
+
+std::optional<int> IncrementalDeserializerPrivate::scanJson()
+{
+	// only brackets and strings are tracked, the actual syntax is verified by the deserialization
+	for (; scanPos < buffer.size(); ++scanPos) {
+		const auto c = buffer.at(scanPos);
+		if (depth == 0) {
+			switch (c) {
+			case ' ':
+			case '\t':
+			case '\n':
+			case '\r':
+				++offset;  // whitespace between values is dropped
+				break;
+			case '{':
+			case '[':
+				depth = 1;
+				break;
+			default:
+				throwJsonError(QJsonParseError::IllegalValue);
+			}
+		} else if (inString) {
+			if (escaped)
+				escaped = false;
+			else if (c == '\\')
+				escaped = true;
+			else if (c == '"')
+				inString = false;
+		} else {
+			switch (c) {
+			case '"':
+				inString = true;
+				break;
+			case '{':
+			case '[':
+				if (++depth > MaxDepth)
+					throwJsonError(QJsonParseError::DeepNesting);
+				break;
+			case '}':
+			case ']':
+				if (--depth == 0)
+					return ++scanPos;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	return std::nullopt;
+}
+
+std::optional<int> IncrementalDeserializerPrivate::scanCbor()
+{
+	while (scanPos < buffer.size()) {
+		// the content of strings is skipped without looking at it
+		if (skip > 0) {
+			const auto count = std::min<qint64>(skip, buffer.size() - scanPos);
+			scanPos += static_cast<int>(count);
+			skip -= count;
+			if (skip > 0)
+				return std::nullopt;
+			if (finishCborItem())
+				return scanPos;
+			continue;
+		}
+
+		const auto initial = static_cast<quint8>(buffer.at(scanPos));
+		const auto majorType = initial >> 5;
+		const auto info = initial & 0x1f;
+		if (info >= 28 && info <= 30)
+			throwCborError(QCborError::IllegalNumber);
+		const auto argSize = info == 24 ? 1 : info == 25 ? 2 : info == 26 ? 4 : info == 27 ? 8 : 0;
+		if (scanPos + 1 + argSize > buffer.size())
+			return std::nullopt;
+
+		quint64 argument = info;
+		const auto argData = buffer.constData() + scanPos + 1;
+		switch (argSize) {
+		case 1:
+			argument = static_cast<quint8>(*argData);
+			break;
+		case 2:
+			argument = qFromBigEndian<quint16>(argData);
+			break;
+		case 4:
+			argument = qFromBigEndian<quint32>(argData);
+			break;
+		case 8:
+			argument = qFromBigEndian<quint64>(argData);
+			break;
+		default:
+			break;
+		}
+		scanPos += 1 + argSize;
+
+		auto done = false;
+		switch (majorType) {
+		case 0:  // unsigned integer
+		case 1:  // negative integer
+			if (info == 31)
+				throwCborError(QCborError::IllegalNumber);
+			done = finishCborItem();
+			break;
+		case 2:  // byte string
+		case 3:  // text string
+			if (info == 31)
+				frames.append(-1);  // the chunks are items of the string, until the break
+			else if (argument > static_cast<quint64>(std::numeric_limits<qint64>::max()))
+				throwCborError(QCborError::DataTooLarge);
+			else if (argument > 0)
+				skip = static_cast<qint64>(argument);
+			else
+				done = finishCborItem();
+			break;
+		case 4:  // array
+		case 5:  // map
+			if (info == 31)
+				frames.append(-1);
+			else if (argument > static_cast<quint64>(std::numeric_limits<qint64>::max() / 2))
+				throwCborError(QCborError::DataTooLarge);
+			else if (argument > 0)
+				frames.append(static_cast<qint64>(majorType == 5 ? argument * 2 : argument));
+			else
+				done = finishCborItem();
+			if (frames.size() > MaxDepth)
+				throwCborError(QCborError::NestingTooDeep);
+			break;
+		case 6:  // tag, belongs to the following item
+			if (info == 31)
+				throwCborError(QCborError::IllegalNumber);
+			break;
+		case 7:  // simple types, floats and the break
+			if (info == 31) {
+				if (frames.isEmpty() || frames.last() != -1)
+					throwCborError(QCborError::UnexpectedBreak);
+				frames.removeLast();
+			}
+			done = finishCborItem();
+			break;
+		default:
+			Q_UNREACHABLE();
+			break;
+		}
+
+		if (done)
+			return scanPos;
+	}
+	return std::nullopt;
+}
+
+bool IncrementalDeserializerPrivate::finishCborItem()
+{
+	// a completed item can complete its container as well
+	while (!frames.isEmpty()) {
+		auto &remaining = frames.last();
+		if (remaining < 0 || --remaining > 0)
+			return false;
+		frames.removeLast();
+	}
+	return true;
+}
+
+QVariant IncrementalDeserializerPrivate::deserialize(const QByteArray &message) const
+{
+	if (jsonSerializer)
+		return jsonSerializer->deserializeFrom(message, metaTypeId, valueParent);
+	else
+		return cborSerializer->deserializeFrom(message, metaTypeId, valueParent);
+}
+
+void IncrementalDeserializerPrivate::throwJsonError(QJsonParseError::ParseError error)
+{
+	QJsonParseError parseError;
+	parseError.error = error;
+	throw DeserializationException{"Failed to read file as JSON with error: " + parseError.errorString().toUtf8()};
+}
+
+void IncrementalDeserializerPrivate::throwCborError(QCborError::Code error)
+{
+	throw DeserializationException("Failed to read file as CBOR with error: " + QCborError{error}.toString().toUtf8());
+}
@@ -0,0 +1,48 @@
+#ifndef QTJSONSERIALIZER_INCREMENTALDESERIALIZER_H
+#define QTJSONSERIALIZER_INCREMENTALDESERIALIZER_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+#include "QtJsonSerializer/serializerbase.h"
+
+#include <QtCore/qobject.h>
+
+namespace QtJsonSerializer {
+
+class IncrementalDeserializerPrivate;
+//! Deserializes values from data that arrives in chunks, for example from a socket
+class Q_JSONSERIALIZER_EXPORT IncrementalDeserializer : public QObject
+{
+	Q_OBJECT
+
+public:
+	//! Constructor, with the JsonSerializer or CborSerializer to use and the type of the values
+	IncrementalDeserializer(const SerializerBase *serializer, int metaTypeId, QObject *parent = nullptr);
+
+	//! Checks if parts of a value have been added, that is not complete yet
+	bool hasPendingData() const;
+	//! Checks if the data was malformed, so that no more values can be deserialized until clear() is called
+	bool hasFailed() const;
+
+	//! Returns the object that is used as parent of deserialized QObjects
+	QObject *valueParent() const;
+	//! Sets the object that is used as parent of deserialized QObjects
+	void setValueParent(QObject *valueParent);
+
+	//! Adds the next chunk of data and deserializes all values that have been completed by it
+	void addData(const QByteArray &data);
+	//! Discards all pending data and leaves the failed state
+	void clear();
+
+Q_SIGNALS:
+	//! Is emitted for every value that has been deserialized from the added data
+	void valueDeserialized(const QVariant &value);
+	//! Is emitted for every value that failed to deserialize, and once if the data is malformed
+	void errorOccurred(const QString &errorString);
+
+private:
+	Q_DECLARE_PRIVATE(IncrementalDeserializer)
+};
+
+}
+
+#endif // QTJSONSERIALIZER_INCREMENTALDESERIALIZER_H
@@ -0,0 +1,62 @@
+#ifndef QTJSONSERIALIZER_INCREMENTALDESERIALIZER_P_H
+#define QTJSONSERIALIZER_INCREMENTALDESERIALIZER_P_H
+
+#include "incrementaldeserializer.h"
+#include "jsonserializer.h"
+#include "cborserializer.h"
+
+#include <optional>
+
+#include <QtCore/QVector>
+#include <QtCore/QPointer>
+
+#include <QtCore/private/qobject_p.h>
+
+namespace QtJsonSerializer {
+
+class Q_JSONSERIALIZER_EXPORT IncrementalDeserializerPrivate : public QObjectPrivate
+{
+	Q_DECLARE_PUBLIC(IncrementalDeserializer)
+
+public:
+	// same as QJsonDocument, to protect the stack of the deserializer
+	static constexpr int MaxDepth = 1024;
+
+	IncrementalDeserializerPrivate(const SerializerBase *serializer, int metaTypeId);
+
+	const JsonSerializer *jsonSerializer;
+	const CborSerializer *cborSerializer;
+	int metaTypeId;
+	QPointer<QObject> valueParent;
+	// set once the end of a value cannot be determined anymore, all data is ignored until cleared
+	bool failed = false;
+
+	// the data of incomplete values, starting at offset
+	QByteArray buffer;
+	int offset = 0;
+	// the scanner state is kept between chunks, so every byte is scanned only once
+	int scanPos = 0;
+
+	// JSON scanner: nesting depth and string state of the current value
+	int depth = 0;
+	bool inString = false;
+	bool escaped = false;
+
+	// CBOR scanner: remaining items of all open containers, -1 for indefinite ones
+	QVector<qint64> frames;
+	qint64 skip = 0;
+
+	void reset();
+	// both return the end of the next complete value in buffer, if there is one
+	std::optional<int> scanJson();
+	std::optional<int> scanCbor();
+	bool finishCborItem();
+	QVariant deserialize(const QByteArray &message) const;
+
+	[[noreturn]] void throwJsonError(QJsonParseError::ParseError error);
+	[[noreturn]] void throwCborError(QCborError::Code error);
+};
+
+}
+
+#endif // QTJSONSERIALIZER_INCREMENTALDESERIALIZER_P_H
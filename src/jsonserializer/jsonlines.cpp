@@ -0,0 +1,70 @@
+#include "jsonlines.h"
+#include "jsonlines_p.h"
+using namespace QtJsonSerializer;
+
+JsonLinesWriter::JsonLinesWriter(const JsonSerializer *serializer, QIODevice *device) :
+	d{new JsonLinesWriterPrivate{serializer, serializer->d_func()->currentSettings(), device}}
+{
+	if (!device->isOpen() || !device->isWritable())
+		throw SerializationException{"QIODevice must be open and writable!"};
+}
+
+JsonLinesWriter::~JsonLinesWriter()
+{
+	d->writer.flush();
+}
+
+void JsonLinesWriter::write(const QVariant &record)
+{
+	const SettingsScope settingsScope{d->serializer->d_func(), d->settings};
+	try {
+		d->serializer->serializeVariantTo(record.userType(), record, d->writer);
+	} catch (...) {
+		// a failed record is dropped completely, so the following records are still valid lines
+		d->writer.discardRecord();
+		throw;
+	}
+}
+
+void JsonLinesWriter::flush()
+{
+	d->writer.flush();
+}
+
+
+
+JsonLinesReader::JsonLinesReader(const JsonSerializer *serializer, QIODevice *device) :
+	d{new JsonLinesReaderPrivate{serializer, serializer->d_func()->currentSettings(), device}}
+{
+	if (!device->isOpen() || !device->isReadable())
+		throw DeserializationException{"QIODevice must be open and readable!"};
+}
+
+JsonLinesReader::~JsonLinesReader() = default;
+
+bool JsonLinesReader::hasNext() const
+{
+	return d->reader.hasNext();
+}
+
+QVariant JsonLinesReader::read(int metaTypeId, QObject *parent)
+{
+	if (!d->reader.hasNext())
+		throw DeserializationException{"No more records to read from the device"};
+	const SettingsScope settingsScope{d->serializer->d_func(), d->settings};
+	return d->serializer->deserializeVariantFrom(metaTypeId, d->reader, parent);
+}
+
+// ------------- private implementation -------------
+
+JsonLinesWriterPrivate::JsonLinesWriterPrivate(const JsonSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device) :
+	serializer{serializer},
+	settings{std::move(settings)},
+	writer{device, QJsonDocument::Compact, true}
+{}
+
+JsonLinesReaderPrivate::JsonLinesReaderPrivate(const JsonSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device) :
+	serializer{serializer},
+	settings{std::move(settings)},
+	reader{device, true}
+{}
@@ -0,0 +1,78 @@
+#ifndef QTJSONSERIALIZER_JSONLINES_H
+#define QTJSONSERIALIZER_JSONLINES_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+#include "QtJsonSerializer/jsonserializer.h"
+
+#include <QtCore/qscopedpointer.h>
+
+namespace QtJsonSerializer {
+
+class JsonLinesWriterPrivate;
+//! Writes independent records to a device in the JSON Lines format, one record per line
+class Q_JSONSERIALIZER_EXPORT JsonLinesWriter
+{
+	Q_DISABLE_COPY(JsonLinesWriter)
+
+public:
+	//! Constructor, with the serializer to use and the device to write to
+	JsonLinesWriter(const JsonSerializer *serializer, QIODevice *device);
+	//! Destructor, flushes all records that have not been written yet
+	~JsonLinesWriter();
+
+	//! Serializes a QVariant value as the next record
+	void write(const QVariant &record);
+	//! Serializes a generic c++ type as the next record
+	template <typename T>
+	void write(const T &record);
+
+	//! Writes all buffered records to the device
+	void flush();
+
+private:
+	QScopedPointer<JsonLinesWriterPrivate> d;
+};
+
+class JsonLinesReaderPrivate;
+//! Reads independent records from a device in the JSON Lines format, one record at a time
+class Q_JSONSERIALIZER_EXPORT JsonLinesReader
+{
+	Q_DISABLE_COPY(JsonLinesReader)
+
+public:
+	//! Constructor, with the serializer to use and the device to read from
+	JsonLinesReader(const JsonSerializer *serializer, QIODevice *device);
+	~JsonLinesReader();
+
+	//! Checks if there are more records to be read
+	bool hasNext() const;
+
+	//! Deserializes the next record to a QVariant value, based on the given type id
+	QVariant read(int metaTypeId, QObject *parent = nullptr);
+	//! Deserializes the next record to the given c++ type
+	template <typename T>
+	T read(QObject *parent = nullptr);
+
+private:
+	QScopedPointer<JsonLinesReaderPrivate> d;
+};
+
+// ------------- Generic Implementation -------------
+
+template<typename T>
+void JsonLinesWriter::write(const T &record)
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be serialized");
+	write(__private::variant_helper<T>::toVariant(record));
+}
+
+template<typename T>
+T JsonLinesReader::read(QObject *parent)
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	return __private::variant_helper<T>::fromVariant(read(qMetaTypeId<T>(), parent));
+}
+
+}
+
+#endif // QTJSONSERIALIZER_JSONLINES_H
@@ -0,0 +1,35 @@
+#ifndef QTJSONSERIALIZER_JSONLINES_P_H
+#define QTJSONSERIALIZER_JSONLINES_P_H
+
+#include "jsonlines.h"
+#include "jsonserializer_p.h"
+#include "valuewriter_p.h"
+#include "valuereader_p.h"
+
+namespace QtJsonSerializer {
+
+class JsonLinesWriterPrivate
+{
+public:
+	JsonLinesWriterPrivate(const JsonSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device);
+
+	const JsonSerializer *serializer;
+	// all records are written with the settings of the time the writer was created
+	QSharedPointer<const SerializerSettings> settings;
+	JsonValueWriter writer;
+};
+
+class JsonLinesReaderPrivate
+{
+public:
+	JsonLinesReaderPrivate(const JsonSerializer *serializer, QSharedPointer<const SerializerSettings> settings, QIODevice *device);
+
+	const JsonSerializer *serializer;
+	// all records are read with the settings of the time the reader was created
+	QSharedPointer<const SerializerSettings> settings;
+	JsonValueReader reader;
+};
+
+}
+
+#endif // QTJSONSERIALIZER_JSONLINES_P_H
@@ -1,5 +1,7 @@
 #include "jsonserializer.h"
 #include "jsonserializer_p.h"
+#include "valuewriter_p.h"
+#include "valuereader_p.h"
 
 #include <QtCore/QBuffer>
 using namespace QtJsonSerializer;
@@ -17,15 +19,10 @@ void JsonSerializer::serializeTo(QIODevice *device, const QVariant &data, QJsonD
 {
 	if (!device->isOpen() || !device->isWritable())
 		throw SerializationException{"QIODevice must be open and writable!"};
-	QJsonDocument doc;
-	const auto jData = serialize(data);
-	if (jData.isArray())
-		doc = QJsonDocument{jData.toArray()};
-	else if (jData.isObject())
-		doc = QJsonDocument{jData.toObject()};
-	else
-		throw SerializationException{"Only objects or arrays can be written to a device!"};
-	device->write(doc.toJson(format));
+	// the text is generated while walking the data, without intermediate CBOR or JSON trees
+	JsonValueWriter writer{device, format};
+	serializeVariantTo(data.userType(), data, writer);
+	writer.flush();
 }
 
 QByteArray JsonSerializer::serializeTo(const QVariant &data, QJsonDocument::JsonFormat format) const
@@ -38,27 +35,34 @@ QByteArray JsonSerializer::serializeTo(const QVariant &data, QJsonDocument::Json
 	return buffer.data();
 }
 
+void JsonSerializer::serializeSequenceTo(QIODevice *device, int elementType, const SequenceGenerator &generator, QJsonDocument::JsonFormat format) const
+{
+	if (!device->isOpen() || !device->isWritable())
+		throw SerializationException{"QIODevice must be open and writable!"};
+	JsonValueWriter writer{device, format};
+	serializeSequenceVariantTo(elementType, generator, writer);
+	writer.flush();
+}
+
 QVariant JsonSerializer::deserialize(const QJsonValue &json, int metaTypeId, QObject *parent) const
 {
 	return deserializeVariant(metaTypeId, QCborValue::fromJsonValue(json), parent);
 }
 
+void JsonSerializer::deserializeInto(const QJsonValue &json, int metaTypeId, void *data, QObject *parent) const
+{
+	deserializeData(metaTypeId, QCborValue::fromJsonValue(json), data, parent);
+}
+
 QVariant JsonSerializer::deserializeFrom(QIODevice *device, int metaTypeId, QObject *parent) const
 {
 	if (!device->isOpen() || !device->isReadable())
 		throw DeserializationException{"QIODevice must be open and readable!"};
-	QJsonParseError error;
-	auto doc = QJsonDocument::fromJson(device->readAll(), &error);
-	if (error.error != QJsonParseError::NoError)
-		throw DeserializationException{"Failed to read file as JSON with error: " + error.errorString().toUtf8()};
-	if (doc.isArray())
-		return deserialize(doc.array(), metaTypeId, parent);
-	else if (doc.isObject())
-		return deserialize(doc.object(), metaTypeId, parent);
-	else if (doc.isNull())
-		return deserialize(QJsonValue::Null, metaTypeId, parent);
-	else
-		return QVariant{};
+	// the text is parsed while deserializing, without intermediate JSON or CBOR trees
+	JsonValueReader reader{device};
+	auto result = deserializeVariantFrom(metaTypeId, reader, parent);
+	reader.finish();
+	return result;
 }
 
 QVariant JsonSerializer::deserializeFrom(const QByteArray &data, int metaTypeId, QObject *parent) const
@@ -71,6 +75,25 @@ QVariant JsonSerializer::deserializeFrom(const QByteArray &data, int metaTypeId,
 	return res;
 }
 
+QVariant JsonSerializer::deserializeAt(QIODevice *device, const QString &pointer, int metaTypeId, QObject *parent) const
+{
+	if (!device->isOpen() || !device->isReadable())
+		throw DeserializationException{"QIODevice must be open and readable!"};
+	// reading stops after the target value, so the rest of the document is neither read nor validated
+	JsonValueReader reader{device};
+	return deserializeVariantAt(metaTypeId, pointer, reader, parent);
+}
+
+QVariant JsonSerializer::deserializeAt(const QByteArray &data, const QString &pointer, int metaTypeId, QObject *parent) const
+{
+	QBuffer buffer(const_cast<QByteArray*>(&data));
+	if (!buffer.open(QIODevice::ReadOnly))
+		throw DeserializationException{"Failed to read from bytearray buffer with error: " + buffer.errorString().toUtf8()};
+	auto res = deserializeAt(&buffer, pointer, metaTypeId, parent);
+	buffer.close();
+	return res;
+}
+
 JsonSerializer::ByteArrayFormat JsonSerializer::byteArrayFormat() const
 {
 	Q_D(const JsonSerializer);
@@ -100,6 +123,7 @@ void JsonSerializer::setByteArrayFormat(JsonSerializer::ByteArrayFormat byteArra
 		return;
 
 	d->byteArrayFormat = byteArrayFormat;
+	d->invalidateSettings();
 	emit byteArrayFormatChanged(d->byteArrayFormat, {});
 }
 
@@ -110,6 +134,7 @@ void JsonSerializer::setValidateBase64(bool validateBase64)
 		return;
 
 	d->validateBase64 = validateBase64;
+	d->invalidateSettings();
 	emit validateBase64Changed(d->validateBase64, {});
 }
 
@@ -141,3 +166,12 @@ QList<int> JsonSerializer::typesForTag(QCborTag tag) const
 	Q_UNUSED(tag)
 	return {};
 }
+
+// ------------- private implementation -------------
+
+void JsonSerializerPrivate::fillSettings(SerializerSettings &settings) const
+{
+	SerializerBasePrivate::fillSettings(settings);
+	settings.byteArrayFormat = static_cast<int>(byteArrayFormat);
+	settings.validateBase64 = validateBase64;
+}
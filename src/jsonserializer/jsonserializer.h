@@ -39,6 +39,8 @@ public:
 	void serializeTo(QIODevice *device, const QVariant &data, QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
 	//! Serializers a QVariant value to a byte array
 	QByteArray serializeTo(const QVariant &data, QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
+	//! Serializers all values yielded by a generator as one JSON array to a device
+	void serializeSequenceTo(QIODevice *device, int elementType, const SequenceGenerator &generator, QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
 
 	//! Serializers a generic c++ type to json
 	template <typename T>
@@ -49,23 +51,44 @@ public:
 	//! Serializers a generic c++ type to a byte array
 	template <typename T>
 	QByteArray serializeTo(const T &data, QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
+	//! Serializers all c++ values yielded by a generator as one JSON array to a device
+	template <typename T, typename TGenerator>
+	void serializeSequenceTo(QIODevice *device, TGenerator &&generator, QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
+	//! Serializers all c++ values of an iterator range as one JSON array to a device
+	template <typename TIterator>
+	void serializeSequenceTo(QIODevice *device, TIterator begin, TIterator end, QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
 
 	//! Deserializes a QJsonValue to a QVariant value, based on the given type id
 	QVariant deserialize(const QJsonValue &json, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes a QJsonValue into existing data of the given type id
+	void deserializeInto(const QJsonValue &json, int metaTypeId, void *data, QObject *parent = nullptr) const;
 	//! Deserializes data from a device to a QVariant value, based on the given type id
 	QVariant deserializeFrom(QIODevice *device, int metaTypeId, QObject *parent = nullptr) const;
 	//! Deserializes data from a device to a QVariant value, based on the given type id
 	QVariant deserializeFrom(const QByteArray &data, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a device to a QVariant value, based on the given type id
+	QVariant deserializeAt(QIODevice *device, const QString &pointer, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a byte array to a QVariant value, based on the given type id
+	QVariant deserializeAt(const QByteArray &data, const QString &pointer, int metaTypeId, QObject *parent = nullptr) const;
 
 	//! Deserializes a json to the given c++ type
 	template <typename T>
 	T deserialize(const typename QtJsonSerializer::__private::json_type<T>::type &json, QObject *parent = nullptr) const;
+	//! Deserializes a json into existing data of the given c++ type
+	template <typename T>
+	void deserializeInto(const typename QtJsonSerializer::__private::json_type<T>::type &json, T &data, QObject *parent = nullptr) const;
 	//! Deserializes data from a device to the given c++ type
 	template <typename T>
 	T deserializeFrom(QIODevice *device, QObject *parent = nullptr) const;
 	//! Deserializes data from a byte array to the given c++ type
 	template <typename T>
 	T deserializeFrom(const QByteArray &data, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a device to the given c++ type
+	template <typename T>
+	T deserializeAt(QIODevice *device, const QString &pointer, QObject *parent = nullptr) const;
+	//! Deserializes only the value at a JSON pointer from a byte array to the given c++ type
+	template <typename T>
+	T deserializeAt(const QByteArray &data, const QString &pointer, QObject *parent = nullptr) const;
 
 	//! @readAcFn{QJsonSerializer::byteArrayFormat}
 	ByteArrayFormat byteArrayFormat() const;
@@ -95,6 +118,8 @@ protected:
 
 private:
 	Q_DECLARE_PRIVATE(JsonSerializer)
+	friend class JsonLinesWriter;
+	friend class JsonLinesReader;
 };
 
 // ------------- Generic Implementation -------------
@@ -103,6 +128,11 @@ template<typename T>
 typename QtJsonSerializer::__private::json_type<T>::type JsonSerializer::serialize(const T &data) const
 {
 	static_assert(__private::is_serializable<T>::value, "T cannot be serialized");
+	if constexpr (__private::static_helper<T>::value) {
+		if (hasStaticPath(qMetaTypeId<T>()))
+			return __private::json_type<T>::convert(__private::static_helper<T>::serialize(data).toJsonValue());
+	} else if constexpr (__private::gadget_helper<T>::value)
+		return __private::json_type<T>::convert(serializeData(qMetaTypeId<T>(), &data).toJsonValue());
 	return __private::json_type<T>::convert(serialize(__private::variant_helper<T>::toVariant(data)));
 }
 
@@ -120,13 +150,52 @@ QByteArray JsonSerializer::serializeTo(const T &data, QJsonDocument::JsonFormat
 	return serializeTo(__private::variant_helper<T>::toVariant(data), format);
 }
 
+template<typename T, typename TGenerator>
+void JsonSerializer::serializeSequenceTo(QIODevice *device, TGenerator &&generator, QJsonDocument::JsonFormat format) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be serialized");
+	serializeSequenceTo(device, qMetaTypeId<T>(), [&]() -> std::optional<QVariant> {
+		if (auto element = generator(); element)
+			return __private::variant_helper<T>::toVariant(*element);
+		else
+			return std::nullopt;
+	}, format);
+}
+
+template<typename TIterator>
+void JsonSerializer::serializeSequenceTo(QIODevice *device, TIterator begin, TIterator end, QJsonDocument::JsonFormat format) const
+{
+	using T = std::decay_t<typename std::iterator_traits<TIterator>::value_type>;
+	serializeSequenceTo<T>(device, [&]() -> std::optional<T> {
+		if (begin != end)
+			return *begin++;
+		else
+			return std::nullopt;
+	}, format);
+}
+
 template<typename T>
 T JsonSerializer::deserialize(const typename __private::json_type<T>::type &json, QObject *parent) const
 {
 	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	if constexpr (__private::static_helper<T>::value) {
+		if (hasStaticPath(qMetaTypeId<T>())) {
+			const auto value = QCborValue::fromJsonValue(json);
+			if (auto data = __private::static_helper<T>::deserialize(value); data)
+				return std::move(*data);
+			return __private::variant_helper<T>::fromVariant(deserializeVariant(qMetaTypeId<T>(), value, parent));
+		}
+	}
 	return __private::variant_helper<T>::fromVariant(deserialize(json, qMetaTypeId<T>(), parent));
 }
 
+template<typename T>
+void JsonSerializer::deserializeInto(const typename __private::json_type<T>::type &json, T &data, QObject *parent) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	deserializeInto(json, qMetaTypeId<T>(), &data, parent);
+}
+
 template<typename T>
 T JsonSerializer::deserializeFrom(QIODevice *device, QObject *parent) const
 {
@@ -141,6 +210,20 @@ T JsonSerializer::deserializeFrom(const QByteArray &data, QObject *parent) const
 	return QtJsonSerializer::__private::variant_helper<T>::fromVariant(deserializeFrom(data, qMetaTypeId<T>(), parent));
 }
 
+template<typename T>
+T JsonSerializer::deserializeAt(QIODevice *device, const QString &pointer, QObject *parent) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	return __private::variant_helper<T>::fromVariant(deserializeAt(device, pointer, qMetaTypeId<T>(), parent));
+}
+
+template<typename T>
+T JsonSerializer::deserializeAt(const QByteArray &data, const QString &pointer, QObject *parent) const
+{
+	static_assert(__private::is_serializable<T>::value, "T cannot be deserialized");
+	return __private::variant_helper<T>::fromVariant(deserializeAt(data, pointer, qMetaTypeId<T>(), parent));
+}
+
 }
 
 #endif // QTJSONSERIALIZER_JSONSERIALIZER_H
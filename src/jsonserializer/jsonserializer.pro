@@ -3,30 +3,49 @@ TARGET = QtJsonSerializer
 QT = core core-private
 
 HEADERS += \
+	cborsequence.h \
+	cborsequence_p.h \
 	cborserializer.h \
 	cborserializer_p.h \
+	cbormapbuilder_p.h \
 	exception.h \
 	exception_p.h \
 	exceptioncontext_p.h \
+	incrementaldeserializer.h \
+	incrementaldeserializer_p.h \
+	jsonlines.h \
+	jsonlines_p.h \
 	jsonserializer.h \
 	jsonserializer_p.h \
 	metawriters.h \
 	metawriters_p.h \
+	propertyplan_p.h \
 	qtjsonserializer_global.h \
 	qtjsonserializer_helpertypes.h \
 	serializerbase.h \
 	serializerbase_p.h \
 	typeconverter.h \
-	typeextractors.h
+	typeextractors.h \
+	valuereader.h \
+	valuereader_p.h \
+	valuewriter.h \
+	valuewriter_p.h
 
 SOURCES += \
+	cborsequence.cpp \
 	cborserializer.cpp \
+	cbormapbuilder.cpp \
 	exception.cpp \
 	exceptioncontext.cpp \
+	incrementaldeserializer.cpp \
+	jsonlines.cpp \
 	jsonserializer.cpp \
 	metawriters.cpp \
+	propertyplan.cpp \
 	serializerbase.cpp \
-	typeconverter.cpp
+	typeconverter.cpp \
+	valuereader.cpp \
+	valuewriter.cpp
 
 include(typeconverters/typeconverters.pri)
 
@@ -14,6 +14,8 @@ public:
 	using ByteArrayFormat = JsonSerializer::ByteArrayFormat;
 	ByteArrayFormat byteArrayFormat = ByteArrayFormat::Base64;
 	bool validateBase64 = true;
+
+	void fillSettings(SerializerSettings &settings) const override;
 };
 
 }
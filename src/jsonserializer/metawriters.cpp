@@ -8,6 +8,8 @@ using namespace QtJsonSerializer::MetaWriters::Implementations;
 
 Q_LOGGING_CATEGORY(QtJsonSerializer::MetaWriters::logSeqWriter, "qt.jsonserializer.metawriters.sequential")
 Q_LOGGING_CATEGORY(QtJsonSerializer::MetaWriters::logAsocWriter, "qt.jsonserializer.metawriters.associative")
+Q_LOGGING_CATEGORY(QtJsonSerializer::MetaWriters::logSeqReader, "qt.jsonserializer.metareaders.sequential")
+Q_LOGGING_CATEGORY(QtJsonSerializer::MetaWriters::logAsocReader, "qt.jsonserializer.metareaders.associative")
 
 void SequentialWriter::registerWriter(int metaTypeId, SequentialWriterFactory *factory)
 {
@@ -61,8 +63,42 @@ SequentialWriter::SequenceInfo SequentialWriter::getInfo(int metaTypeId)
 	}
 }
 
+bool SequentialWriter::getWriter(QVariant &data, ScopedWriter<SequentialWriter> &writer)
+{
+	QReadLocker _{&MetaWritersPrivate::sequenceLock};
+	const auto factory = MetaWritersPrivate::sequenceFactories.value(data.userType());
+	if (factory) {
+		// prefer constructing the writer in place, only custom factories without support are allocated
+		if (const auto inPlaceWriter = factory->createAt(writer.storage(), data.data()); inPlaceWriter)
+			writer.reset(inPlaceWriter);
+		else
+			writer.reset(factory->create(data.data()));
+		return true;
+	} else {
+		qCWarning(logSeqWriter) << "Unable to find factory for data of type:" << QMetaType::typeName(data.userType());
+		return false;
+	}
+}
+
 SequentialWriter::~SequentialWriter() = default;
 
+void SequentialWriter::emplace(QVariant &&value)
+{
+	add(value);
+}
+
+void SequentialWriter::addRange(QVariantList &&values)
+{
+	for (auto &value : values)
+		emplace(std::move(value));
+}
+
+void *SequentialWriter::resizeData(int size)
+{
+	Q_UNUSED(size)
+	return nullptr;
+}
+
 SequentialWriter::SequentialWriter() = default;
 
 
@@ -71,6 +107,13 @@ SequentialWriterFactory::SequentialWriterFactory() = default;
 
 SequentialWriterFactory::~SequentialWriterFactory() = default;
 
+SequentialWriter *SequentialWriterFactory::createAt(void *storage, void *data) const
+{
+	Q_UNUSED(storage)
+	Q_UNUSED(data)
+	return nullptr;
+}
+
 
 
 void AssociativeWriter::registerWriter(int metaTypeId, AssociativeWriterFactory *factory)
@@ -125,8 +168,34 @@ AssociativeWriter::AssociationInfo AssociativeWriter::getInfo(int metaTypeId)
 	}
 }
 
+bool AssociativeWriter::getWriter(QVariant &data, ScopedWriter<AssociativeWriter> &writer)
+{
+	QReadLocker _{&MetaWritersPrivate::associationLock};
+	const auto factory = MetaWritersPrivate::associationFactories.value(data.userType());
+	if (factory) {
+		if (const auto inPlaceWriter = factory->createAt(writer.storage(), data.data()); inPlaceWriter)
+			writer.reset(inPlaceWriter);
+		else
+			writer.reset(factory->create(data.data()));
+		return true;
+	} else {
+		qCWarning(logAsocWriter) << "Unable to find factory for data of type:" << QMetaType::typeName(data.userType());
+		return false;
+	}
+}
+
 AssociativeWriter::~AssociativeWriter() = default;
 
+void AssociativeWriter::emplace(QVariant &&key, QVariant &&value)
+{
+	add(key, value);
+}
+
+void AssociativeWriter::reserve(int size)
+{
+	Q_UNUSED(size)
+}
+
 AssociativeWriter::AssociativeWriter() = default;
 
 
@@ -135,8 +204,130 @@ AssociativeWriterFactory::AssociativeWriterFactory() = default;
 
 AssociativeWriterFactory::~AssociativeWriterFactory() = default;
 
+AssociativeWriter *AssociativeWriterFactory::createAt(void *storage, void *data) const
+{
+	Q_UNUSED(storage)
+	Q_UNUSED(data)
+	return nullptr;
+}
 
 
+
+void SequentialReader::registerReader(int metaTypeId, SequentialReaderFactory *factory)
+{
+	Q_ASSERT_X(factory, Q_FUNC_INFO, "factory must not be null!");
+	QWriteLocker _{&MetaWritersPrivate::sequenceReaderLock};
+	MetaWritersPrivate::sequenceReaderFactories.insert(metaTypeId, factory);
+	qCDebug(logSeqReader) << "Added factory for type:" << QMetaType::typeName(metaTypeId);
+}
+
+bool SequentialReader::canRead(int metaTypeId)
+{
+	QReadLocker _{&MetaWritersPrivate::sequenceReaderLock};
+	return MetaWritersPrivate::sequenceReaderFactories.contains(metaTypeId);
+}
+
+bool SequentialReader::getReader(const QVariant &data, ScopedReader<SequentialReader> &reader)
+{
+	return getReader(data.userType(), data.constData(), reader);
+}
+
+bool SequentialReader::getReader(int metaTypeId, const void *data, ScopedReader<SequentialReader> &reader)
+{
+	QReadLocker _{&MetaWritersPrivate::sequenceReaderLock};
+	const auto factory = MetaWritersPrivate::sequenceReaderFactories.value(metaTypeId);
+	if (factory) {
+		// like for the writers, only custom factories without support are allocated
+		if (const auto inPlaceReader = factory->createAt(reader.storage(), data); inPlaceReader)
+			reader.reset(inPlaceReader);
+		else
+			reader.reset(factory->create(data));
+		return true;
+	} else {
+		// not an error, callers fall back to QSequentialIterable
+		qCDebug(logSeqReader) << "Unable to find factory for data of type:" << QMetaType::typeName(metaTypeId);
+		return false;
+	}
+}
+
+SequentialReader::~SequentialReader() = default;
+
+const void *SequentialReader::constData() const
+{
+	return nullptr;
+}
+
+SequentialReader::SequentialReader() = default;
+
+
+
+SequentialReaderFactory::SequentialReaderFactory() = default;
+
+SequentialReaderFactory::~SequentialReaderFactory() = default;
+
+SequentialReader *SequentialReaderFactory::createAt(void *storage, const void *data) const
+{
+	Q_UNUSED(storage)
+	Q_UNUSED(data)
+	return nullptr;
+}
+
+
+
+void AssociativeReader::registerReader(int metaTypeId, AssociativeReaderFactory *factory)
+{
+	Q_ASSERT_X(factory, Q_FUNC_INFO, "factory must not be null!");
+	QWriteLocker _{&MetaWritersPrivate::associationReaderLock};
+	MetaWritersPrivate::associationReaderFactories.insert(metaTypeId, factory);
+	qCDebug(logAsocReader) << "Added factory for type:" << QMetaType::typeName(metaTypeId);
+}
+
+bool AssociativeReader::canRead(int metaTypeId)
+{
+	QReadLocker _{&MetaWritersPrivate::associationReaderLock};
+	return MetaWritersPrivate::associationReaderFactories.contains(metaTypeId);
+}
+
+bool AssociativeReader::getReader(const QVariant &data, ScopedReader<AssociativeReader> &reader)
+{
+	return getReader(data.userType(), data.constData(), reader);
+}
+
+bool AssociativeReader::getReader(int metaTypeId, const void *data, ScopedReader<AssociativeReader> &reader)
+{
+	QReadLocker _{&MetaWritersPrivate::associationReaderLock};
+	const auto factory = MetaWritersPrivate::associationReaderFactories.value(metaTypeId);
+	if (factory) {
+		// like for the writers, only custom factories without support are allocated
+		if (const auto inPlaceReader = factory->createAt(reader.storage(), data); inPlaceReader)
+			reader.reset(inPlaceReader);
+		else
+			reader.reset(factory->create(data));
+		return true;
+	} else {
+		// not an error, callers fall back to QAssociativeIterable
+		qCDebug(logAsocReader) << "Unable to find factory for data of type:" << QMetaType::typeName(metaTypeId);
+		return false;
+	}
+}
+
+AssociativeReader::~AssociativeReader() = default;
+
+AssociativeReader::AssociativeReader() = default;
+
+
+
+AssociativeReaderFactory::AssociativeReaderFactory() = default;
+
+AssociativeReaderFactory::~AssociativeReaderFactory() = default;
+
+AssociativeReader *AssociativeReaderFactory::createAt(void *storage, const void *data) const
+{
+	Q_UNUSED(storage)
+	Q_UNUSED(data)
+	return nullptr;
+}
+
 SequentialWriterImpl<QList, QVariant>::SequentialWriterImpl(QVariantList *data)
 	: _data{data}
 {}
@@ -156,6 +347,19 @@ void SequentialWriterImpl<QList, QVariant>::add(const QVariant &value)
 	_data->append(value);
 }
 
+void SequentialWriterImpl<QList, QVariant>::emplace(QVariant &&value)
+{
+	_data->append(std::move(value));
+}
+
+void SequentialWriterImpl<QList, QVariant>::addRange(QVariantList &&values)
+{
+	if (_data->isEmpty())
+		*_data = std::move(values);
+	else
+		_data->append(values);
+}
+
 
 
 AssociativeWriterImpl<QMap, QString, QVariant>::AssociativeWriterImpl(QVariantMap *data)
@@ -172,6 +376,16 @@ void AssociativeWriterImpl<QMap, QString, QVariant>::add(const QVariant &key, co
 	_data->insert(key.toString(), value);
 }
 
+void AssociativeWriterImpl<QMap, QString, QVariant>::emplace(QVariant &&key, QVariant &&value)
+{
+	_data->insert(key.toString(), std::move(value));
+}
+
+void AssociativeWriterImpl<QMap, QString, QVariant>::reserve(int size)
+{
+	Q_UNUSED(size)
+}
+
 AssociativeWriterImpl<QHash, QString, QVariant>::AssociativeWriterImpl(QVariantHash *data)
 	: _data{data}
 {}
@@ -186,6 +400,16 @@ void AssociativeWriterImpl<QHash, QString, QVariant>::add(const QVariant &key, c
 	_data->insert(key.toString(), value);
 }
 
+void AssociativeWriterImpl<QHash, QString, QVariant>::emplace(QVariant &&key, QVariant &&value)
+{
+	_data->insert(key.toString(), std::move(value));
+}
+
+void AssociativeWriterImpl<QHash, QString, QVariant>::reserve(int size)
+{
+	_data->reserve(size);
+}
+
 // ------------- private implementation -------------
 
 QReadWriteLock MetaWritersPrivate::sequenceLock;
@@ -203,6 +427,19 @@ QHash<int, AssociativeWriterFactory*> MetaWritersPrivate::associationFactories {
 };
 QHash<int, AssociativeWriter::AssociationInfo> MetaWritersPrivate::associationInfoCache;
 
+QReadWriteLock MetaWritersPrivate::sequenceReaderLock;
+QHash<int, SequentialReaderFactory*> MetaWritersPrivate::sequenceReaderFactories {
+	{QMetaType::QStringList, new SequentialReaderFactoryQStringList{}},
+	{QMetaType::QByteArrayList, new SequentialReaderFactoryQByteArrayList{}},
+	{QMetaType::QVariantList, new SequentialReaderFactoryImpl<QList, QVariant>{}}
+};
+
+QReadWriteLock MetaWritersPrivate::associationReaderLock;
+QHash<int, AssociativeReaderFactory*> MetaWritersPrivate::associationReaderFactories {
+	{QMetaType::QVariantMap, new AssociativeReaderFactoryImpl<QMap, QString, QVariant>{}},
+	{QMetaType::QVariantHash, new AssociativeReaderFactoryImpl<QHash, QString, QVariant>{}}
+};
+
 SequentialWriter::SequenceInfo MetaWritersPrivate::tryParseSequenceInfo(int metaTypeId)
 {
 	if (metaTypeId == QMetaType::QStringList)
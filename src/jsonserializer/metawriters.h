@@ -10,10 +10,112 @@
 #include <QtCore/qreadwritelock.h>
 
 #include <QtCore/qset.h>
+#include <QtCore/qvector.h>
 #include <QtCore/qlinkedlist.h>
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
 namespace QtJsonSerializer::MetaWriters {
 
+//! Holds a writer or reader that was constructed in place if its factory supports it, or on the heap otherwise
+template <typename TWriter>
+class ScopedWriter
+{
+	Q_DISABLE_COPY(ScopedWriter)
+
+public:
+	//! The number of bytes available to factories to construct writers in place
+	static constexpr std::size_t StorageSize = 4 * sizeof(void*);
+
+	ScopedWriter() = default;
+	~ScopedWriter() {
+		clear();
+	}
+
+	//! Returns the held writer, or nullptr if none was set
+	TWriter *get() const {
+		return _writer;
+	}
+	//! Member access to the held writer
+	TWriter *operator->() const {
+		return _writer;
+	}
+	//! Dereferences the held writer
+	TWriter &operator*() const {
+		return *_writer;
+	}
+	//! Checks if a writer is held
+	explicit operator bool() const {
+		return _writer;
+	}
+
+	//! @private
+	void *storage() {
+		return &_storage;
+	}
+	//! @private
+	void reset(TWriter *inPlaceWriter) {
+		clear();
+		_writer = inPlaceWriter;
+		_inPlace = true;
+	}
+	//! @private
+	void reset(QSharedPointer<TWriter> heapWriter) {
+		clear();
+		_heapWriter = std::move(heapWriter);
+		_writer = _heapWriter.data();
+	}
+
+private:
+	std::aligned_storage_t<StorageSize, alignof(std::max_align_t)> _storage;
+	TWriter *_writer = nullptr;
+	bool _inPlace = false;
+	QSharedPointer<TWriter> _heapWriter;
+
+	void clear() {
+		if (_inPlace)
+			_writer->~TWriter();
+		_writer = nullptr;
+		_inPlace = false;
+		_heapWriter.reset();
+	}
+};
+
+//! Holds a reader that was constructed in place if its factory supports it, or on the heap otherwise
+template <typename TReader>
+using ScopedReader = ScopedWriter<TReader>;
+
+//! A non-owning reference to a callable, used to visit container elements without allocating
+template <typename TSignature>
+class VisitorRef;
+
+//! @copydoc VisitorRef
+template <typename... TArgs>
+class VisitorRef<void(TArgs...)>
+{
+public:
+	//! Wraps the callable, which must outlive the reference
+	template <typename TFunc, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TFunc>, VisitorRef>>>
+	VisitorRef(TFunc &&func) :
+		_callable{const_cast<void*>(static_cast<const void*>(std::addressof(func)))},
+		_invoke{[](void *callable, TArgs... args) {
+			(*static_cast<std::remove_reference_t<TFunc>*>(callable))(args...);
+		}}
+	{}
+
+	//! Calls the referenced callable
+	void operator()(TArgs... args) const {
+		_invoke(_callable, args...);
+	}
+
+private:
+	void *_callable;
+	void (*_invoke)(void *, TArgs...);
+};
+
 class SequentialWriterFactory;
 //! The writer class for sequential containers
 class Q_JSONSERIALIZER_EXPORT SequentialWriter
@@ -38,6 +140,8 @@ public:
 	static bool canWrite(int metaTypeId);
 	//! Returns a writer instance for the given data, or nullptr if none found
 	static QSharedPointer<SequentialWriter> getWriter(QVariant &data);
+	//! Creates a writer for the given data in writer, without allocating it if possible. Returns false if none found
+	static bool getWriter(QVariant &data, ScopedWriter<SequentialWriter> &writer);
 	//! Returns the information details of the given type
 	static SequenceInfo getInfo(int metaTypeId);
 
@@ -48,6 +152,12 @@ public:
 	virtual void reserve(int size) = 0;
 	//! Adds an element to the "end" of the container
 	virtual void add(const QVariant &value) = 0;
+	//! Adds an element to the "end" of the container, moving it out of the variant if possible
+	virtual void emplace(QVariant &&value);
+	//! Adds all elements to the "end" of the container, moving them out of the variants if possible
+	virtual void addRange(QVariantList &&values);
+	//! Resizes the container to size elements and returns their storage, or nullptr if the elements are not stored contiguously
+	virtual void *resizeData(int size);
 
 protected:
 	//! @private
@@ -64,6 +174,8 @@ public:
 	virtual ~SequentialWriterFactory();
 	//! Factory method to create the instance. data can be null for read-only writers
 	virtual QSharedPointer<SequentialWriter> create(void *data) const = 0;
+	//! Constructs the instance in storage of ScopedWriter::StorageSize bytes, or returns nullptr if not supported
+	virtual SequentialWriter *createAt(void *storage, void *data) const;
 };
 
 
@@ -92,6 +204,8 @@ public:
 	static bool canWrite(int metaTypeId);
 	//! Returns a writer instance for the given data, or nullptr if none found
 	static QSharedPointer<AssociativeWriter> getWriter(QVariant &data);
+	//! Creates a writer for the given data in writer, without allocating it if possible. Returns false if none found
+	static bool getWriter(QVariant &data, ScopedWriter<AssociativeWriter> &writer);
 	//! Returns the information details of the given type
 	static AssociationInfo getInfo(int metaTypeId);
 
@@ -100,6 +214,10 @@ public:
 	virtual AssociationInfo info() const = 0;
 	//! Inserts the given value for the given key into the container
 	virtual void add(const QVariant &key, const QVariant &value) = 0;
+	//! Inserts the given value for the given key into the container, moving them out of the variants if possible
+	virtual void emplace(QVariant &&key, QVariant &&value);
+	//! Reserves space for size entries in the container, if it supports it
+	virtual void reserve(int size);
 
 protected:
 	//! @private
@@ -116,12 +234,139 @@ public:
 	virtual ~AssociativeWriterFactory();
 	//! Factory method to create the instance. data can be null for read-only writers
 	virtual QSharedPointer<AssociativeWriter> create(void *data) const = 0;
+	//! Constructs the instance in storage of ScopedWriter::StorageSize bytes, or returns nullptr if not supported
+	virtual AssociativeWriter *createAt(void *storage, void *data) const;
+};
+
+class SequentialReaderFactory;
+//! The reader class for sequential containers, to access elements without wrapping them in variants
+class Q_JSONSERIALIZER_EXPORT SequentialReader
+{
+	Q_DISABLE_COPY(SequentialReader)
+
+public:
+	//! Information about a sequential container, the same as for the writer
+	using SequenceInfo = SequentialWriter::SequenceInfo;
+	//! The callback type used to visit elements. The pointer is only valid during the call
+	using ElementVisitor = VisitorRef<void(const void *)>;
+
+	//! Registers a container factory for the given container and value classes
+	template <template<typename> class TContainer, typename TClass>
+	static void registerReader();
+	//! @copybrief SequentialReader::registerReader()
+	static void registerReader(int metaTypeId, SequentialReaderFactory *factory);
+	//! Checks if a reader exists for the given type
+	static bool canRead(int metaTypeId);
+	//! Creates a reader for the given data in reader, without allocating it if possible. Returns false if none found
+	static bool getReader(const QVariant &data, ScopedReader<SequentialReader> &reader);
+	//! Creates a reader for the data of the given type in reader, without allocating it if possible. Returns false if none found
+	static bool getReader(int metaTypeId, const void *data, ScopedReader<SequentialReader> &reader);
+
+	virtual ~SequentialReader();
+	//! Return the information for the wrapped container
+	virtual SequenceInfo info() const = 0;
+	//! Returns the number of elements in the container
+	virtual int size() const = 0;
+	//! Calls the visitor with a pointer to every element of the container, in order
+	virtual void forEach(ElementVisitor visitor) const = 0;
+	//! Returns a pointer to the elements, or nullptr if they are not stored contiguously
+	virtual const void *constData() const;
+
+protected:
+	//! @private
+	SequentialReader();
+};
+
+//! A factory to create sequential reader instances from container data
+class Q_JSONSERIALIZER_EXPORT SequentialReaderFactory
+{
+	Q_DISABLE_COPY(SequentialReaderFactory)
+
+public:
+	SequentialReaderFactory();
+	virtual ~SequentialReaderFactory();
+	//! Factory method to create the instance. data can be null for info-only readers
+	virtual QSharedPointer<SequentialReader> create(const void *data) const = 0;
+	//! Constructs the instance in storage of ScopedReader::StorageSize bytes, or returns nullptr if not supported
+	virtual SequentialReader *createAt(void *storage, const void *data) const;
+};
+
+
+
+class AssociativeReaderFactory;
+//! The reader class for associative containers, to access entries without wrapping them in variants
+class Q_JSONSERIALIZER_EXPORT AssociativeReader
+{
+	Q_DISABLE_COPY(AssociativeReader)
+
+public:
+	//! Information about a associative container, the same as for the writer
+	using AssociationInfo = AssociativeWriter::AssociationInfo;
+	//! The callback type used to visit entries. The pointers are only valid during the call
+	using EntryVisitor = VisitorRef<void(const void *, const void *)>;
+
+	//! Registers a container factory for the given container, key and value classes
+	template <template<typename, typename> class TContainer, typename TKey, typename TValue>
+	static void registerReader();
+	//! @copybrief AssociativeReader::registerReader()
+	static void registerReader(int metaTypeId, AssociativeReaderFactory *factory);
+	//! Checks if a reader exists for the given type
+	static bool canRead(int metaTypeId);
+	//! Creates a reader for the given data in reader, without allocating it if possible. Returns false if none found
+	static bool getReader(const QVariant &data, ScopedReader<AssociativeReader> &reader);
+	//! Creates a reader for the data of the given type in reader, without allocating it if possible. Returns false if none found
+	static bool getReader(int metaTypeId, const void *data, ScopedReader<AssociativeReader> &reader);
+
+	virtual ~AssociativeReader();
+	//! Return the information for the wrapped container
+	virtual AssociationInfo info() const = 0;
+	//! Returns the number of entries in the container
+	virtual int size() const = 0;
+	//! Calls the visitor with pointers to the key and value of every entry of the container
+	virtual void forEach(EntryVisitor visitor) const = 0;
+
+protected:
+	//! @private
+	AssociativeReader();
+};
+
+//! A factory to create associative reader instances from container data
+class Q_JSONSERIALIZER_EXPORT AssociativeReaderFactory
+{
+	Q_DISABLE_COPY(AssociativeReaderFactory)
+
+public:
+	AssociativeReaderFactory();
+	virtual ~AssociativeReaderFactory();
+	//! Factory method to create the instance. data can be null for info-only readers
+	virtual QSharedPointer<AssociativeReader> create(const void *data) const = 0;
+	//! Constructs the instance in storage of ScopedReader::StorageSize bytes, or returns nullptr if not supported
+	virtual AssociativeReader *createAt(void *storage, const void *data) const;
 };
 
 // ------------- Generic Implementation classes -------------
 
 namespace Implementations {
 
+template <typename T>
+T takeVariantValue(QVariant &value) {
+	if constexpr (std::is_same_v<T, QVariant>)
+		return std::move(value);
+	else if (value.userType() == qMetaTypeId<T>())
+		return std::move(*reinterpret_cast<T*>(value.data()));
+	else
+		return value.template value<T>();
+}
+
+template <template<typename> class TContainer, typename TClass>
+using is_contiguous = std::is_base_of<QVector<TClass>, TContainer<TClass>>;
+
+template <typename TContainer, typename = void>
+struct has_reserve : public std::false_type {};
+
+template <typename TContainer>
+struct has_reserve<TContainer, std::void_t<decltype(std::declval<TContainer&>().reserve(0))>> : public std::true_type {};
+
 template <template<typename> class TContainer, typename TClass>
 class SequentialWriterImpl final : public SequentialWriter
 {
@@ -142,6 +387,26 @@ public:
 		_data->append(value.template value<TClass>());
 	}
 
+	void emplace(QVariant &&value) final {
+		_data->append(takeVariantValue<TClass>(value));
+	}
+
+	void addRange(QVariantList &&values) final {
+		_data->reserve(_data->size() + values.size());
+		for (auto &value : values)
+			_data->append(takeVariantValue<TClass>(value));
+	}
+
+	void *resizeData(int size) final {
+		if constexpr (is_contiguous<TContainer, TClass>::value) {
+			_data->resize(size);
+			return _data->data();
+		} else {
+			Q_UNUSED(size)
+			return nullptr;
+		}
+	}
+
 private:
 	TContainer<TClass> *_data;
 };
@@ -153,6 +418,11 @@ public:
 	QSharedPointer<SequentialWriter> create(void *data) const final {
 		return QSharedPointer<SequentialWriterImpl<TContainer, TClass>>::create(reinterpret_cast<TContainer<TClass>*>(data));
 	}
+
+	SequentialWriter *createAt(void *storage, void *data) const final {
+		static_assert(sizeof(SequentialWriterImpl<TContainer, TClass>) <= ScopedWriter<SequentialWriter>::StorageSize);
+		return new (storage) SequentialWriterImpl<TContainer, TClass>{reinterpret_cast<TContainer<TClass>*>(data)};
+	}
 };
 
 
@@ -174,6 +444,18 @@ public:
 					  value.template value<TValue>());
 	}
 
+	void emplace(QVariant &&key, QVariant &&value) final {
+		_data->insert(takeVariantValue<TKey>(key),
+					  takeVariantValue<TValue>(value));
+	}
+
+	void reserve(int size) final {
+		Q_UNUSED(size)
+		// only hash based containers can be reserved
+		if constexpr (has_reserve<TContainer<TKey, TValue>>::value)
+			_data->reserve(size);
+	}
+
 private:
 	TContainer<TKey, TValue> *_data;
 };
@@ -185,6 +467,107 @@ public:
 	QSharedPointer<AssociativeWriter> create(void *data) const final {
 		return QSharedPointer<AssociativeWriterImpl<TContainer, TKey, TValue>>::create(reinterpret_cast<TContainer<TKey, TValue>*>(data));
 	}
+
+	AssociativeWriter *createAt(void *storage, void *data) const final {
+		static_assert(sizeof(AssociativeWriterImpl<TContainer, TKey, TValue>) <= ScopedWriter<AssociativeWriter>::StorageSize);
+		return new (storage) AssociativeWriterImpl<TContainer, TKey, TValue>{reinterpret_cast<TContainer<TKey, TValue>*>(data)};
+	}
+};
+
+
+
+template <template<typename> class TContainer, typename TClass>
+class SequentialReaderImpl final : public SequentialReader
+{
+public:
+	SequentialReaderImpl(const TContainer<TClass> *data)
+		: _data{data}
+	{}
+
+	SequenceInfo info() const final {
+		// variant elements are passed as-is, like for the writers
+		if constexpr (std::is_same_v<TClass, QVariant>)
+			return {QMetaType::UnknownType, false};
+		else
+			return {qMetaTypeId<TClass>(), std::is_same_v<TContainer<TClass>, QSet<TClass>>};
+	}
+
+	int size() const final {
+		return _data->size();
+	}
+
+	void forEach(ElementVisitor visitor) const final {
+		for (const auto &element : *_data)
+			visitor(&element);
+	}
+
+	const void *constData() const final {
+		if constexpr (is_contiguous<TContainer, TClass>::value)
+			return _data->constData();
+		else
+			return nullptr;
+	}
+
+private:
+	const TContainer<TClass> *_data;
+};
+
+template <template<typename> class TContainer, typename TClass>
+class SequentialReaderFactoryImpl final : public SequentialReaderFactory
+{
+public:
+	QSharedPointer<SequentialReader> create(const void *data) const final {
+		return QSharedPointer<SequentialReaderImpl<TContainer, TClass>>::create(reinterpret_cast<const TContainer<TClass>*>(data));
+	}
+
+	SequentialReader *createAt(void *storage, const void *data) const final {
+		static_assert(sizeof(SequentialReaderImpl<TContainer, TClass>) <= ScopedReader<SequentialReader>::StorageSize);
+		return new (storage) SequentialReaderImpl<TContainer, TClass>{reinterpret_cast<const TContainer<TClass>*>(data)};
+	}
+};
+
+
+
+template <template<typename, typename> class TContainer, typename TKey, typename TValue>
+class AssociativeReaderImpl final : public AssociativeReader
+{
+public:
+	AssociativeReaderImpl(const TContainer<TKey, TValue> *data)
+		: _data{data}
+	{}
+
+	AssociationInfo info() const final {
+		if constexpr (std::is_same_v<TValue, QVariant>)
+			return {qMetaTypeId<TKey>(), QMetaType::UnknownType};
+		else
+			return {qMetaTypeId<TKey>(), qMetaTypeId<TValue>()};
+	}
+
+	int size() const final {
+		return _data->size();
+	}
+
+	void forEach(EntryVisitor visitor) const final {
+		for (auto it = _data->constBegin(), end = _data->constEnd(); it != end; ++it)
+			visitor(&it.key(), &it.value());
+	}
+
+private:
+	const TContainer<TKey, TValue> *_data;
+};
+
+template <template<typename, typename> class TContainer, typename TKey, typename TValue>
+class AssociativeReaderFactoryImpl final : public AssociativeReaderFactory
+{
+public:
+	QSharedPointer<AssociativeReader> create(const void *data) const final {
+		return QSharedPointer<AssociativeReaderImpl<TContainer, TKey, TValue>>::create(reinterpret_cast<const TContainer<TKey, TValue>*>(data));
+	}
+
+	AssociativeReader *createAt(void *storage, const void *data) const final {
+		static_assert(sizeof(AssociativeReaderImpl<TContainer, TKey, TValue>) <= ScopedReader<AssociativeReader>::StorageSize);
+		return new (storage) AssociativeReaderImpl<TContainer, TKey, TValue>{reinterpret_cast<const TContainer<TKey, TValue>*>(data)};
+	}
 };
 
 // ------------- Specializations and base generic implementations -------------
@@ -209,6 +592,10 @@ public:
 		_data->insert(value.template value<TClass>());
 	}
 
+	void emplace(QVariant &&value) final {
+		_data->insert(takeVariantValue<TClass>(value));
+	}
+
 private:
 	QSet<TClass> *_data;
 };
@@ -231,6 +618,10 @@ public:
 		_data->append(value.template value<TClass>());
 	}
 
+	void emplace(QVariant &&value) final {
+		_data->append(takeVariantValue<TClass>(value));
+	}
+
 private:
 	QLinkedList<TClass> *_data;
 };
@@ -244,6 +635,8 @@ public:
 	SequenceInfo info() const final;
 	void reserve(int size) final;
 	void add(const QVariant &value) final;
+	void emplace(QVariant &&value) final;
+	void addRange(QVariantList &&values) final;
 
 private:
 	QVariantList *_data;
@@ -259,6 +652,8 @@ public:
 
 	AssociationInfo info() const final;
 	void add(const QVariant &key, const QVariant &value) final;
+	void emplace(QVariant &&key, QVariant &&value) final;
+	void reserve(int size) final;
 
 private:
 	QVariantMap *_data;
@@ -272,6 +667,8 @@ public:
 
 	AssociationInfo info() const final;
 	void add(const QVariant &key, const QVariant &value) final;
+	void emplace(QVariant &&key, QVariant &&value) final;
+	void reserve(int size) final;
 
 private:
 	QVariantHash *_data;
@@ -293,6 +690,20 @@ void AssociativeWriter::registerWriter()
 				   new Implementations::AssociativeWriterFactoryImpl<TContainer, TKey, TValue>{});
 }
 
+template<template<typename> class TContainer, typename TClass>
+void SequentialReader::registerReader()
+{
+	registerReader(qMetaTypeId<TContainer<TClass>>(),
+				   new Implementations::SequentialReaderFactoryImpl<TContainer, TClass>{});
+}
+
+template<template<typename, typename> class TContainer, typename TKey, typename TValue>
+void AssociativeReader::registerReader()
+{
+	registerReader(qMetaTypeId<TContainer<TKey, TValue>>(),
+				   new Implementations::AssociativeReaderFactoryImpl<TContainer, TKey, TValue>{});
+}
+
 }
 
 #endif // QTJSONSERIALIZER_METAWRITERS_H
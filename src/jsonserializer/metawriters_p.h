@@ -18,12 +18,20 @@ public:
 	static QHash<int, AssociativeWriterFactory*> associationFactories;
 	static QHash<int, AssociativeWriter::AssociationInfo> associationInfoCache;
 
+	static QReadWriteLock sequenceReaderLock;
+	static QHash<int, SequentialReaderFactory*> sequenceReaderFactories;
+
+	static QReadWriteLock associationReaderLock;
+	static QHash<int, AssociativeReaderFactory*> associationReaderFactories;
+
 	static SequentialWriter::SequenceInfo tryParseSequenceInfo(int metaTypeId);
 	static AssociativeWriter::AssociationInfo tryParseAssociationInfo(int metaTypeId);
 };
 
 Q_DECLARE_LOGGING_CATEGORY(logSeqWriter)
 Q_DECLARE_LOGGING_CATEGORY(logAsocWriter)
+Q_DECLARE_LOGGING_CATEGORY(logSeqReader)
+Q_DECLARE_LOGGING_CATEGORY(logAsocReader)
 
 
 
@@ -35,6 +43,10 @@ public:
 	QSharedPointer<SequentialWriter> create(void *data) const final {
 		return QSharedPointer<SequentialWriterImpl<QList, QString>>::create(reinterpret_cast<QStringList*>(data));
 	}
+
+	SequentialWriter *createAt(void *storage, void *data) const final {
+		return new (storage) SequentialWriterImpl<QList, QString>{reinterpret_cast<QStringList*>(data)};
+	}
 };
 
 class SequentialWriterFactoryQByteArrayList : public SequentialWriterFactory
@@ -43,6 +55,10 @@ public:
 	QSharedPointer<SequentialWriter> create(void *data) const final {
 		return QSharedPointer<SequentialWriterImpl<QList, QByteArray>>::create(reinterpret_cast<QByteArrayList*>(data));
 	}
+
+	SequentialWriter *createAt(void *storage, void *data) const final {
+		return new (storage) SequentialWriterImpl<QList, QByteArray>{reinterpret_cast<QByteArrayList*>(data)};
+	}
 };
 
 class SequentialWriterFactoryQVariantList : public SequentialWriterFactory
@@ -51,6 +67,10 @@ public:
 	QSharedPointer<SequentialWriter> create(void *data) const final {
 		return QSharedPointer<SequentialWriterImpl<QList, QVariant>>::create(reinterpret_cast<QVariantList*>(data));
 	}
+
+	SequentialWriter *createAt(void *storage, void *data) const final {
+		return new (storage) SequentialWriterImpl<QList, QVariant>{reinterpret_cast<QVariantList*>(data)};
+	}
 };
 
 
@@ -61,6 +81,10 @@ public:
 	QSharedPointer<AssociativeWriter> create(void *data) const final {
 		return QSharedPointer<AssociativeWriterImpl<QMap, QString, QVariant>>::create(reinterpret_cast<QVariantMap*>(data));
 	}
+
+	AssociativeWriter *createAt(void *storage, void *data) const final {
+		return new (storage) AssociativeWriterImpl<QMap, QString, QVariant>{reinterpret_cast<QVariantMap*>(data)};
+	}
 };
 
 class AssociativeWriterFactoryQVariantHash : public AssociativeWriterFactory
@@ -69,6 +93,36 @@ public:
 	QSharedPointer<AssociativeWriter> create(void *data) const final {
 		return QSharedPointer<AssociativeWriterImpl<QHash, QString, QVariant>>::create(reinterpret_cast<QVariantHash*>(data));
 	}
+
+	AssociativeWriter *createAt(void *storage, void *data) const final {
+		return new (storage) AssociativeWriterImpl<QHash, QString, QVariant>{reinterpret_cast<QVariantHash*>(data)};
+	}
+};
+
+
+
+class SequentialReaderFactoryQStringList : public SequentialReaderFactory
+{
+public:
+	QSharedPointer<SequentialReader> create(const void *data) const final {
+		return QSharedPointer<SequentialReaderImpl<QList, QString>>::create(reinterpret_cast<const QStringList*>(data));
+	}
+
+	SequentialReader *createAt(void *storage, const void *data) const final {
+		return new (storage) SequentialReaderImpl<QList, QString>{reinterpret_cast<const QStringList*>(data)};
+	}
+};
+
+class SequentialReaderFactoryQByteArrayList : public SequentialReaderFactory
+{
+public:
+	QSharedPointer<SequentialReader> create(const void *data) const final {
+		return QSharedPointer<SequentialReaderImpl<QList, QByteArray>>::create(reinterpret_cast<const QByteArrayList*>(data));
+	}
+
+	SequentialReader *createAt(void *storage, const void *data) const final {
+		return new (storage) SequentialReaderImpl<QList, QByteArray>{reinterpret_cast<const QByteArrayList*>(data)};
+	}
 };
 
 }
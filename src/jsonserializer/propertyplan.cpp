@@ -0,0 +1,112 @@
+#include "propertyplan_p.h"
+
+#include <algorithm>
+
+#include <QtCore/QCache>
+using namespace QtJsonSerializer;
+
+namespace {
+
+struct PlanKey {
+	const QMetaObject *metaObject;
+	int firstIndex;
+	bool ignoreStoredAttribute;
+
+	inline bool operator==(const PlanKey &other) const {
+		return metaObject == other.metaObject &&
+				firstIndex == other.firstIndex &&
+				ignoreStoredAttribute == other.ignoreStoredAttribute;
+	}
+};
+
+inline uint qHash(const PlanKey &key, uint seed = 0) {
+	return ::qHash(key.metaObject, seed) ^
+			::qHash(key.firstIndex, seed) ^
+			::qHash(key.ignoreStoredAttribute, seed);
+}
+
+// plans are immutable and cheap to build, so every thread keeps its own cache to avoid locking.
+// The cache is bounded, the least recently used plans are rebuilt when needed again
+constexpr int MaxCachedPlans = 256;
+thread_local QCache<PlanKey, QSharedPointer<const PropertyPlan>> planCache{MaxCachedPlans};
+
+}
+
+QSharedPointer<const PropertyPlan> PropertyPlan::get(const QMetaObject *metaObject, int firstIndex, bool ignoreStoredAttribute)
+{
+	const PlanKey key {metaObject, firstIndex, ignoreStoredAttribute};
+	if (const auto cached = planCache.object(key); cached)
+		return *cached;
+	// evicted plans stay valid for as long as they are still in use
+	const QSharedPointer<const PropertyPlan> plan = QSharedPointer<PropertyPlan>::create(metaObject, firstIndex, ignoreStoredAttribute);
+	planCache.insert(key, new QSharedPointer<const PropertyPlan>{plan});
+	return plan;
+}
+
+int PropertyPlan::enumTypeId(const QMetaEnum &metaEnum)
+{
+	QByteArray eName = metaEnum.name();
+	if (const QByteArray scope = metaEnum.scope(); !scope.isEmpty())
+		eName = scope + "::" + eName;
+	return QMetaType::type(eName);
+}
+
+PropertyPlan::PropertyPlan(const QMetaObject *metaObject, int firstIndex, bool ignoreStoredAttribute) :
+	_metaObject{metaObject}
+{
+	// all properties can be deserialized, but only the selected ones are serialized (and required)
+	_properties.reserve(metaObject->propertyCount() - firstIndex);
+	_keyIndex.reserve(metaObject->propertyCount());
+	for (auto i = 0; i < metaObject->propertyCount(); ++i) {
+		const auto property = metaObject->property(i);
+		// unresolvable enums keep UnknownType, the serializer reports the error when the property is used
+		Property info {
+			property,
+			property.isEnumType() ? enumTypeId(property.enumerator()) : property.userType(),
+			QString::fromUtf8(property.name())
+		};
+		// properties shadowed by a subclass share the required slot
+		const auto shadowed = _keyIndex.constFind(info.key);
+		info.requiredIndex = shadowed != _keyIndex.constEnd() ? shadowed->requiredIndex : -1;
+		if (i >= firstIndex && (ignoreStoredAttribute || property.isStored())) {
+			if (info.requiredIndex == -1) {
+				info.requiredIndex = _requiredKeys.size();
+				_requiredKeys.append(info.key);
+			}
+			// a serialized shadowed property is replaced in place, so every key is written exactly once
+			auto serialized = _properties.end();
+			if (shadowed != _keyIndex.constEnd()) {
+				serialized = std::find_if(_properties.begin(), _properties.end(), [&](const Property &other) {
+					return other.key == info.key;
+				});
+			}
+			if (serialized != _properties.end())
+				*serialized = info;
+			else
+				_properties.append(info);
+		}
+		// like QMetaObject::indexOfProperty, the most derived property wins
+		_keyIndex.insert(info.key, info);
+	}
+}
+
+const QMetaObject *PropertyPlan::metaObject() const
+{
+	return _metaObject;
+}
+
+const QVector<PropertyPlan::Property> &PropertyPlan::properties() const
+{
+	return _properties;
+}
+
+const PropertyPlan::Property *PropertyPlan::find(const QString &key) const
+{
+	const auto it = _keyIndex.constFind(key);
+	return it != _keyIndex.constEnd() ? &(*it) : nullptr;
+}
+
+const QVector<QString> &PropertyPlan::requiredKeys() const
+{
+	return _requiredKeys;
+}
@@ -0,0 +1,46 @@
+#ifndef QTJSONSERIALIZER_PROPERTYPLAN_P_H
+#define QTJSONSERIALIZER_PROPERTYPLAN_P_H
+
+#include "qtjsonserializer_global.h"
+
+#include <QtCore/QMetaObject>
+#include <QtCore/QMetaProperty>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+
+namespace QtJsonSerializer {
+
+class Q_JSONSERIALIZER_EXPORT PropertyPlan
+{
+	Q_DISABLE_COPY(PropertyPlan)
+
+public:
+	struct Property {
+		QMetaProperty property;
+		int typeId = QMetaType::UnknownType;
+		QString key;
+		int requiredIndex = -1;
+	};
+
+	static QSharedPointer<const PropertyPlan> get(const QMetaObject *metaObject, int firstIndex, bool ignoreStoredAttribute);
+	static int enumTypeId(const QMetaEnum &metaEnum);
+
+	PropertyPlan(const QMetaObject *metaObject, int firstIndex, bool ignoreStoredAttribute);
+
+	const QMetaObject *metaObject() const;
+	const QVector<Property> &properties() const;
+	const Property *find(const QString &key) const;
+	const QVector<QString> &requiredKeys() const;
+
+private:
+	const QMetaObject *_metaObject;
+	QVector<Property> _properties;
+	QHash<QString, Property> _keyIndex;
+	QVector<QString> _requiredKeys;
+};
+
+}
+
+#endif // QTJSONSERIALIZER_PROPERTYPLAN_P_H
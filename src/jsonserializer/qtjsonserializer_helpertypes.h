@@ -21,6 +21,7 @@
 #include <QtCore/qcbormap.h>
 #include <QtCore/qcborarray.h>
 
+#include <limits>
 #include <type_traits>
 #include <tuple>
 #include <optional>
@@ -314,6 +315,111 @@ struct variant_helper<QVariant> {
 	}
 };
 
+
+// types with a static path, that converts them without boxing every value in a QVariant.
+// It only reproduces the standard behaviour, so the serializer decides at runtime whether it may be used
+template <typename T>
+struct static_helper : public std::false_type {};
+
+template <>
+struct static_helper<bool> : public std::true_type {
+	static inline QCborValue serialize(bool data) {
+		return data;
+	}
+	static inline std::optional<bool> deserialize(const QCborValue &value) {
+		if (value.isBool())
+			return value.toBool();
+		else
+			return std::nullopt;
+	}
+};
+
+template <>
+struct static_helper<int> : public std::true_type {
+	static inline QCborValue serialize(int data) {
+		return data;
+	}
+	static inline std::optional<int> deserialize(const QCborValue &value) {
+		if (const auto data = value.toInteger();
+			value.isInteger() &&
+			data >= std::numeric_limits<int>::min() &&
+			data <= std::numeric_limits<int>::max())
+			return static_cast<int>(data);
+		else
+			return std::nullopt;
+	}
+};
+
+template <>
+struct static_helper<qint64> : public std::true_type {
+	static inline QCborValue serialize(qint64 data) {
+		return data;
+	}
+	static inline std::optional<qint64> deserialize(const QCborValue &value) {
+		if (value.isInteger())
+			return value.toInteger();
+		else
+			return std::nullopt;
+	}
+};
+
+template <>
+struct static_helper<double> : public std::true_type {
+	static inline QCborValue serialize(double data) {
+		return data;
+	}
+	static inline std::optional<double> deserialize(const QCborValue &value) {
+		if (value.isDouble())
+			return value.toDouble();
+		else
+			return std::nullopt;
+	}
+};
+
+template <>
+struct static_helper<QString> : public std::true_type {
+	static inline QCborValue serialize(const QString &data) {
+		return data;
+	}
+	static inline std::optional<QString> deserialize(const QCborValue &value) {
+		if (value.isString())
+			return value.toString();
+		else
+			return std::nullopt;
+	}
+};
+
+template <typename TList>
+struct static_list_helper : public std::bool_constant<static_helper<typename TList::value_type>::value> {
+	using TValue = typename TList::value_type;
+
+	static inline QCborValue serialize(const TList &data) {
+		QCborArray array;
+		for (const auto &element : data)
+			array.append(static_helper<TValue>::serialize(element));
+		return array;
+	}
+	static inline std::optional<TList> deserialize(const QCborValue &value) {
+		if (!value.isArray())
+			return std::nullopt;
+		const auto array = value.toArray();
+		TList list;
+		list.reserve(static_cast<int>(array.size()));
+		for (const auto &element : array) {
+			auto data = static_helper<TValue>::deserialize(element);
+			if (!data)
+				return std::nullopt;
+			list.append(std::move(*data));
+		}
+		return list;
+	}
+};
+
+template <typename T>
+struct static_helper<QList<T>> : public static_list_helper<QList<T>> {};
+
+template <typename T>
+struct static_helper<QVector<T>> : public static_list_helper<QVector<T>> {};
 }
 
 #endif // QTJSONSERIALIZER_HELPERTYPES_H
@@ -1,10 +1,12 @@
 #include "serializerbase.h"
 #include "serializerbase_p.h"
 #include "exceptioncontext_p.h"
+#include "propertyplan_p.h"
 
 #include <optional>
 #include <variant>
 #include <cmath>
+#include <algorithm>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QCoreApplication>
@@ -33,6 +35,85 @@
 using namespace QtJsonSerializer;
 using namespace QtJsonSerializer::TypeConverters;
 
+namespace {
+
+struct ActiveSettings {
+	const SerializerBasePrivate *owner = nullptr;
+	// points to the snapshot held by the outermost SettingsScope
+	const QSharedPointer<const SerializerSettings> *snapshot = nullptr;
+};
+thread_local ActiveSettings scopedSettings;
+
+// direct conversions between the numeric types CBOR and JSON produce, with the same results as QVariant::convert
+bool coerceNumber(QVariant &variant, int propertyType)
+{
+	switch (variant.userType()) {
+	case QMetaType::Double: {
+		const auto value = *static_cast<const double*>(variant.constData());
+		switch (propertyType) {
+		case QMetaType::Int:
+			variant.setValue(static_cast<int>(qRound64(value)));
+			return true;
+		case QMetaType::LongLong:
+			variant.setValue(static_cast<qlonglong>(qRound64(value)));
+			return true;
+		default:
+			return false;
+		}
+	}
+	case QMetaType::LongLong: {
+		const auto value = *static_cast<const qlonglong*>(variant.constData());
+		switch (propertyType) {
+		case QMetaType::Int:
+			variant.setValue(static_cast<int>(value));
+			return true;
+		case QMetaType::Double:
+			variant.setValue(static_cast<double>(value));
+			return true;
+		default:
+			return false;
+		}
+	}
+	default:
+		return false;
+	}
+}
+
+// converts a deserialized variant to the requested property type
+QVariant enforcePropertyType(int propertyType, QVariant variant, bool valueIsNull, bool allowDefaultNull)
+{
+	auto vType = variant.typeName();
+
+	// exclude special values that can convert from null, but should not do so
+	auto allowConvert = true;
+	switch (propertyType) {
+	case QMetaType::QString:
+	case QMetaType::QByteArray:
+		if (valueIsNull)
+			allowConvert = false;
+		break;
+	default:
+		break;
+	}
+
+	// the converters mostly produce the target type already, so the QMetaType conversion is only used as a fallback
+	if (allowConvert && (variant.userType() == propertyType ||
+						 coerceNumber(variant, propertyType) ||
+						 (variant.canConvert(propertyType) && variant.convert(propertyType))))
+		return variant;
+	else if(allowDefaultNull && valueIsNull)
+		return QVariant{propertyType, nullptr};
+	else {
+		throw DeserializationException(QByteArray("Failed to convert deserialized variant of type ") +
+									   (vType ? vType : "<unknown>") +
+									   QByteArray(" to property type ") +
+									   QMetaType::typeName(propertyType) +
+									   QByteArray(". Make shure to register converters with the QJsonSerializer::register* methods"));
+	}
+}
+
+}
+
 #ifndef NO_REGISTER_JSON_CONVERTERS
 namespace {
 void qtJsonSerializerRegisterTypes() {
@@ -141,6 +222,7 @@ void SerializerBase::addJsonTypeConverterFactory(TypeConverterFactory *factory)
 {
 	QWriteLocker _{&SerializerBasePrivate::typeConverterFactoryLock};
 	SerializerBasePrivate::typeConverterFactories.append(factory);
+	SerializerBasePrivate::typeConverterFactoryCount.storeRelease(SerializerBasePrivate::typeConverterFactories.size());
 	qCDebug(logSerializer) << "Added new global converter factory:" << factory;
 }
 
@@ -150,8 +232,7 @@ void SerializerBase::addJsonTypeConverter(const QSharedPointer<TypeConverter> &c
 	Q_ASSERT_X(converter, Q_FUNC_INFO, "converter must not be null!");
 	converter->setHelper(this);
 	d->typeConverters.insertSorted(converter);
-	d->serCache.clear();
-	d->deserCache.clear();
+	d->clearConverterCaches();
 	qCDebug(logSerializer) << "Added new local converter:" << converter->name();
 }
 
@@ -162,6 +243,7 @@ void SerializerBase::setAllowDefaultNull(bool allowDefaultNull)
 		return;
 
 	d->allowNull = allowDefaultNull;
+	d->invalidateSettings();
 	emit allowDefaultNullChanged(d->allowNull, {});
 }
 
@@ -172,6 +254,7 @@ void SerializerBase::setKeepObjectName(bool keepObjectName)
 		return;
 
 	d->keepObjectName = keepObjectName;
+	d->invalidateSettings();
 	emit keepObjectNameChanged(d->keepObjectName, {});
 }
 
@@ -182,6 +265,7 @@ void SerializerBase::setEnumAsString(bool enumAsString)
 		return;
 
 	d->enumAsString = enumAsString;
+	d->invalidateSettings();
 	emit enumAsStringChanged(d->enumAsString, {});
 }
 
@@ -192,6 +276,7 @@ void SerializerBase::setVersionAsString(bool versionAsString)
 		return;
 
 	d->versionAsString = versionAsString;
+	d->invalidateSettings();
 	emit versionAsStringChanged(d->versionAsString, {});
 }
 
@@ -202,6 +287,7 @@ void SerializerBase::setDateAsTimeStamp(bool dateAsTimeStamp)
 		return;
 
 	d->dateAsTimeStamp = dateAsTimeStamp;
+	d->invalidateSettings();
 	emit dateAsTimeStampChanged(d->dateAsTimeStamp, {});
 }
 
@@ -212,6 +298,7 @@ void SerializerBase::setUseBcp47Locale(bool useBcp47Locale)
 		return;
 
 	d->useBcp47Locale = useBcp47Locale;
+	d->invalidateSettings();
 	emit useBcp47LocaleChanged(d->useBcp47Locale, {});
 }
 
@@ -222,6 +309,7 @@ void SerializerBase::setValidationFlags(ValidationFlags validationFlags)
 		return;
 
 	d->validationFlags = validationFlags;
+	d->invalidateSettings();
 	emit validationFlagsChanged(d->validationFlags, {});
 }
 
@@ -232,6 +320,7 @@ void SerializerBase::setPolymorphing(SerializerBase::Polymorphing polymorphing)
 		return;
 
 	d->polymorphing = polymorphing;
+	d->invalidateSettings();
 	emit polymorphingChanged(d->polymorphing, {});
 }
 
@@ -242,6 +331,7 @@ void SerializerBase::setMultiMapMode(SerializerBase::MultiMapMode multiMapMode)
 		return;
 
 	d->multiMapMode = multiMapMode;
+	d->invalidateSettings();
 	emit multiMapModeChanged(d->multiMapMode, {});
 }
 
@@ -252,6 +342,7 @@ void SerializerBase::setIgnoreStoredAttribute(bool ignoreStoredAttribute)
 		return;
 
 	d->ignoreStoredAttribute = ignoreStoredAttribute;
+	d->invalidateSettings();
 	emit ignoreStoredAttributeChanged(d->ignoreStoredAttribute, {});
 }
 
@@ -260,6 +351,15 @@ QVariant SerializerBase::getProperty(const char *name) const
 	return property(name);
 }
 
+QSharedPointer<const SerializerSettings> SerializerBase::settings() const
+{
+	Q_D(const SerializerBase);
+	if (auto active = d->activeSnapshot(); active)
+		return active;
+	else  // not within a de/serialization -> the caller keeps the current snapshot alive
+		return d->currentSettings();
+}
+
 QSharedPointer<const TypeExtractor> SerializerBase::extractor(int metaTypeId) const
 {
 	const auto extractor = SerializerBasePrivate::extractors.get(metaTypeId);
@@ -271,25 +371,27 @@ QSharedPointer<const TypeExtractor> SerializerBase::extractor(int metaTypeId) co
 }
 
 QCborValue SerializerBase::serializeSubtype(const QMetaProperty &property, const QVariant &value) const
+{
+	// enum types are resolved by the typed overload
+	return serializeSubtype(property,
+							property.isEnumType() ? QMetaType::UnknownType : property.userType(),
+							value);
+}
+
+QCborValue SerializerBase::serializeSubtype(const QMetaProperty &property, int propertyType, const QVariant &value) const
 {
 	Q_D(const SerializerBase);
 	ExceptionContext ctx(property);
+	if (propertyType == QMetaType::UnknownType && property.isEnumType())
+		propertyType = d->getEnumId(property.enumerator(), true);
 	auto logGuard = qScopeGuard([](){
 		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
 							   << "done";
 	});
-	if (property.isEnumType()) {
-		const auto enumId = d->getEnumId(property.enumerator(), true);
-		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
-							   << "Serializing subtype property" << property.name()
-							   << "of enum type" << QMetaType::typeName(enumId);
-		return serializeVariant(enumId, value);
-	} else {
-		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
-							   << "Serializing subtype property" << property.name()
-							   << "of type" << QMetaType::typeName(property.userType());
-		return serializeVariant(property.userType(), value);
-	}
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Serializing subtype property" << property.name()
+						   << (property.isEnumType() ? "of enum type" : "of type") << QMetaType::typeName(propertyType);
+	return serializeVariant(propertyType, value);
 }
 
 QCborValue SerializerBase::serializeSubtype(int propertyType, const QVariant &value, const QByteArray &traceHint) const
@@ -306,25 +408,28 @@ QCborValue SerializerBase::serializeSubtype(int propertyType, const QVariant &va
 }
 
 QVariant SerializerBase::deserializeSubtype(const QMetaProperty &property, const QCborValue &value, QObject *parent) const
+{
+	// enum types are resolved by the typed overload
+	return deserializeSubtype(property,
+							  property.isEnumType() ? QMetaType::UnknownType : property.userType(),
+							  value,
+							  parent);
+}
+
+QVariant SerializerBase::deserializeSubtype(const QMetaProperty &property, int propertyType, const QCborValue &value, QObject *parent) const
 {
 	Q_D(const SerializerBase);
 	ExceptionContext ctx(property);
+	if (propertyType == QMetaType::UnknownType && property.isEnumType())
+		propertyType = d->getEnumId(property.enumerator(), false);
 	auto logGuard = qScopeGuard([](){
 		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
 							   << "done";
 	});
-	if (property.isEnumType()) {
-		const auto enumId = d->getEnumId(property.enumerator(), false);
-		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
-							   << "Deserializing subtype property" << property.name()
-							   << "of enum type" << QMetaType::typeName(enumId);
-		return deserializeVariant(enumId, value, parent, true);
-	} else {
-		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
-							   << "Deserializing subtype property" << property.name()
-							   << "of type" << QMetaType::typeName(property.userType());
-		return deserializeVariant(property.userType(), value, parent);
-	}
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Deserializing subtype property" << property.name()
+						   << (property.isEnumType() ? "of enum type" : "of type") << QMetaType::typeName(propertyType);
+	return deserializeVariant(propertyType, value, parent, property.isEnumType());
 }
 
 QVariant SerializerBase::deserializeSubtype(int propertyType, const QCborValue &value, QObject *parent, const QByteArray &traceHint) const
@@ -340,9 +445,101 @@ QVariant SerializerBase::deserializeSubtype(int propertyType, const QCborValue &
 	return deserializeVariant(propertyType, value, parent);
 }
 
+void SerializerBase::serializeSubtypeTo(const QMetaProperty &property, int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	Q_D(const SerializerBase);
+	ExceptionContext ctx(property);
+	if (propertyType == QMetaType::UnknownType && property.isEnumType())
+		propertyType = d->getEnumId(property.enumerator(), true);
+	auto logGuard = qScopeGuard([](){
+		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+							   << "done";
+	});
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Serializing subtype property" << property.name()
+						   << (property.isEnumType() ? "of enum type" : "of type") << QMetaType::typeName(propertyType);
+	serializeVariantTo(propertyType, value, writer);
+}
+
+void SerializerBase::serializeSubtypeTo(int propertyType, const QVariant &value, ValueWriter &writer, const QByteArray &traceHint) const
+{
+	ExceptionContext ctx(propertyType, traceHint);
+	auto logGuard = qScopeGuard([](){
+		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+							   << "done";
+	});
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Serializing subtype property" << traceHint
+						   << "of type" << QMetaType::typeName(propertyType);
+	serializeVariantTo(propertyType, value, writer);
+}
+
+QVariant SerializerBase::deserializeSubtypeFrom(const QMetaProperty &property, int propertyType, ValueReader &reader, QObject *parent) const
+{
+	Q_D(const SerializerBase);
+	ExceptionContext ctx(property);
+	if (propertyType == QMetaType::UnknownType && property.isEnumType())
+		propertyType = d->getEnumId(property.enumerator(), false);
+	auto logGuard = qScopeGuard([](){
+		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+							   << "done";
+	});
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Deserializing subtype property" << property.name()
+						   << (property.isEnumType() ? "of enum type" : "of type") << QMetaType::typeName(propertyType);
+	return deserializeVariantFrom(propertyType, reader, parent, property.isEnumType());
+}
+
+QVariant SerializerBase::deserializeSubtypeFrom(int propertyType, ValueReader &reader, QObject *parent, const QByteArray &traceHint) const
+{
+	ExceptionContext ctx(propertyType, traceHint);
+	auto logGuard = qScopeGuard([](){
+		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+							   << "done";
+	});
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Deserializing subtype property" << traceHint
+						   << "of type" << QMetaType::typeName(propertyType);
+	return deserializeVariantFrom(propertyType, reader, parent);
+}
+
+QCborValue SerializerBase::serializeSubtypeData(int propertyType, const void *data, const QByteArray &traceHint) const
+{
+	ExceptionContext ctx(propertyType, traceHint);
+	auto logGuard = qScopeGuard([](){
+		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+							   << "done";
+	});
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Serializing subtype data" << traceHint
+						   << "of type" << QMetaType::typeName(propertyType);
+	// untyped elements are variants already
+	if (propertyType == QMetaType::UnknownType)
+		return serializeVariant(propertyType, *static_cast<const QVariant*>(data));
+	else
+		return serializeData(propertyType, data);
+}
+
+void SerializerBase::serializeSubtypeDataTo(int propertyType, const void *data, ValueWriter &writer, const QByteArray &traceHint) const
+{
+	ExceptionContext ctx(propertyType, traceHint);
+	auto logGuard = qScopeGuard([](){
+		qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+							   << "done";
+	});
+	qCDebug(logSerializer) << QByteArray{">"}.repeated(ExceptionContext::currentDepth()).constData()
+						   << "Serializing subtype data" << traceHint
+						   << "of type" << QMetaType::typeName(propertyType);
+	if (propertyType == QMetaType::UnknownType)
+		serializeVariantTo(propertyType, *static_cast<const QVariant*>(data), writer);
+	else
+		serializeDataTo(propertyType, data, writer);
+}
+
 QCborValue SerializerBase::serializeVariant(int propertyType, const QVariant &value) const
 {
 	Q_D(const SerializerBase);
+	const SettingsScope settingsScope{d};
 	// first: find a converter and convert to cbor
 	auto converter = d->findSerConverter(propertyType);
 	QCborValue res;
@@ -358,9 +555,67 @@ QCborValue SerializerBase::serializeVariant(int propertyType, const QVariant &va
 		return res;
 }
 
+void SerializerBase::serializeVariantTo(int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	Q_D(const SerializerBase);
+	const SettingsScope settingsScope{d};
+	// the override tag replaces the tag the converter writes first, just like in serializeVariant
+	if (const auto mTag = typeTag(propertyType); mTag != TypeConverter::NoTag)
+		writer.overrideTag(mTag);
+	if (auto converter = d->findSerConverter(propertyType); converter)
+		converter->serializeTo(propertyType, value, writer);
+	else
+		writer.append(d->serializeValue(propertyType, value));
+}
+
+QCborValue SerializerBase::serializeData(int propertyType, const void *data) const
+{
+	Q_D(const SerializerBase);
+	const SettingsScope settingsScope{d};
+	// same as serializeVariant, but converters can read the value without copying it into a QVariant first
+	QCborValue res;
+	if (auto converter = d->findSerConverter(propertyType); converter)
+		res = converter->serializeData(propertyType, data);
+	else
+		res = d->serializeValue(propertyType, QVariant{propertyType, data});
+
+	if (const auto mTag = typeTag(propertyType); mTag != TypeConverter::NoTag)
+		return {mTag, res.isTag() ? res.taggedValue() : res};
+	else
+		return res;
+}
+
+void SerializerBase::serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const
+{
+	Q_D(const SerializerBase);
+	const SettingsScope settingsScope{d};
+	if (const auto mTag = typeTag(propertyType); mTag != TypeConverter::NoTag)
+		writer.overrideTag(mTag);
+	if (auto converter = d->findSerConverter(propertyType); converter)
+		converter->serializeDataTo(propertyType, data, writer);
+	else
+		writer.append(d->serializeValue(propertyType, QVariant{propertyType, data}));
+}
+
+void SerializerBase::serializeSequenceVariantTo(int elementType, const SequenceGenerator &generator, ValueWriter &writer) const
+{
+	Q_D(const SerializerBase);
+	const SettingsScope settingsScope{d};
+	// elements are pulled one at a time, so only the current element is ever held in memory
+	writer.startArray(-1);
+	ExceptionContext::Element ctx{0};
+	auto index = 0;
+	while (const auto element = generator()) {
+		ctx.setIndex(index++);
+		serializeSubtypeTo(elementType, *element, writer, {});
+	}
+	writer.endArray();
+}
+
 QVariant SerializerBase::deserializeVariant(int propertyType, const QCborValue &value, QObject *parent, bool skipConversion) const
 {
 	Q_D(const SerializerBase);
+	const SettingsScope settingsScope{d};
 	// first: find a converter and convert the data to QVariant
 	auto converter = d->findDeserConverter(propertyType,
 										   value.isTag() ? value.tag() : TypeConverter::NoTag,
@@ -380,34 +635,141 @@ QVariant SerializerBase::deserializeVariant(int propertyType, const QCborValue &
 	}
 
 	// second: if the type was given, enforce a conversion to that type (expect if skipped)
-	if(!skipConversion && propertyType != QMetaType::UnknownType) {
-		auto vType = variant.typeName();
+	if(!skipConversion && propertyType != QMetaType::UnknownType)
+		return enforcePropertyType(propertyType, std::move(variant), value.isNull(), settingsScope->allowDefaultNull);
+	else
+		return variant;
+}
 
-		// exclude special values that can convert from null, but should not do so
-		auto allowConvert = true;
-		switch (propertyType) {
-		case QMetaType::QString:
-		case QMetaType::QByteArray:
-			if (value.isNull())
-				allowConvert = false;
+void SerializerBase::deserializeData(int propertyType, const QCborValue &value, void *data, QObject *parent) const
+{
+	Q_D(const SerializerBase);
+	Q_ASSERT_X(propertyType != QMetaType::UnknownType, Q_FUNC_INFO, "The type of the data must be known");
+	const SettingsScope settingsScope{d};
+	// like for container elements, a QVariant holds whatever type the data describes
+	if (propertyType == QMetaType::QVariant) {
+		*static_cast<QVariant*>(data) = deserializeVariant(QMetaType::UnknownType, value, parent);
+		return;
+	}
+
+	// converters that support it write into the data directly, for all others the deserialized variant is assigned
+	auto converterType = propertyType;
+	const auto converter = d->findDeserConverter(converterType,
+												 value.isTag() ? value.tag() : TypeConverter::NoTag,
+												 value.isTag() ? value.taggedValue().type() : value.type());
+	if (converter &&
+		converterType == propertyType &&
+		converter->deserializeInto(propertyType, value, data, parent))
+		return;
+
+	const auto variant = deserializeVariant(propertyType, value, parent);
+	if (variant.userType() != propertyType) {
+		throw DeserializationException(QByteArray("Failed to convert deserialized variant of type ") +
+									   (variant.typeName() ? variant.typeName() : "<unknown>") +
+									   QByteArray(" to property type ") +
+									   QMetaType::typeName(propertyType));
+	}
+
+	QMetaType::destruct(propertyType, data);
+	try {
+		QMetaType::construct(propertyType, data, variant.constData());
+	} catch (...) {
+		// never leave the data destroyed, as the caller still owns and destructs it
+		QMetaType::construct(propertyType, data, nullptr);
+		throw;
+	}
+}
+
+QVariant SerializerBase::deserializeVariantFrom(int propertyType, ValueReader &reader, QObject *parent, bool skipConversion) const
+{
+	Q_D(const SerializerBase);
+	const SettingsScope settingsScope{d};
+	// only arrays, maps and byte arrays (which can reference the data) are streamed into the converters, everything else is read as a whole
+	const auto type = reader.type();
+	if (type != QCborValue::Array && type != QCborValue::Map && type != QCborValue::ByteArray)
+		return deserializeVariant(propertyType, reader.read(), parent, skipConversion);
+
+	// first: find a converter and convert the data to QVariant
+	auto converter = d->findDeserConverter(propertyType, reader.tag(), type);
+	QVariant variant;
+	if (converter)
+		variant = converter->deserializeFrom(propertyType, reader, parent);
+	else {
+		const auto value = reader.read();
+		if (jsonMode())
+			variant = d->deserializeJsonValue(propertyType, value);
+		else
+			variant = d->deserializeCborValue(propertyType, value);
+	}
+
+	// second: if the type was given, enforce a conversion to that type (expect if skipped)
+	if(!skipConversion && propertyType != QMetaType::UnknownType)
+		return enforcePropertyType(propertyType, std::move(variant), false, settingsScope->allowDefaultNull);
+	else
+		return variant;
+}
+
+bool SerializerBase::hasStaticPath(int metaTypeId) const
+{
+	Q_D(const SerializerBase);
+	// the settings of an active scope can differ from the current ones, so the decision is only memoized outside of them
+	if (const auto settings = d->activeSettings(); settings)
+		return d->computeStaticPath(metaTypeId, *settings);
+
+	// like the capabilities, the memo is reset whenever converters, type tags or settings change
+	const auto generation = d->deserCache.generation();
+	if (const auto slot = d->deserCache.find(metaTypeId); slot) {
+		if (const auto state = slot->staticPath.loadAcquire(); state != SerializerBasePrivate::StaticPathUnknown)
+			return state == SerializerBasePrivate::StaticPathEnabled;
+	}
+	const auto enabled = d->computeStaticPath(metaTypeId, *d->currentSettings());
+	d->deserCache.update(metaTypeId, generation, [enabled](SerializerBasePrivate::DeserSlot &slot) {
+		slot.staticPath.storeRelease(enabled ?
+										 SerializerBasePrivate::StaticPathEnabled :
+										 SerializerBasePrivate::StaticPathDisabled);
+	});
+	return enabled;
+}
+
+QVariant SerializerBase::deserializeVariantAt(int propertyType, const QString &pointer, ValueReader &reader, QObject *parent) const
+{
+	// only the containers on the path are entered, all siblings before the target are skipped without decoding them
+	for (const auto &token : SerializerBasePrivate::parseJsonPointer(pointer)) {
+		auto found = false;
+		switch (reader.type()) {
+		case QCborValue::Array: {
+			auto ok = false;
+			const auto index = token.toLongLong(&ok);
+			if (!ok ||
+				!std::all_of(token.cbegin(), token.cend(), [](QChar c) { return c >= QLatin1Char('0') && c <= QLatin1Char('9'); }) ||
+				(token.size() > 1 && token.startsWith(QLatin1Char('0'))))
+				throw DeserializationException{"Invalid array index \"" + token.toUtf8() + "\" in JSON pointer: " + pointer.toUtf8()};
+			reader.enterContainer();
+			for (auto i = 0ll; i < index && reader.hasNext(); ++i)
+				reader.skip();
+			found = reader.hasNext();
+			break;
+		}
+		case QCborValue::Map:
+			reader.enterContainer();
+			while (reader.hasNext()) {
+				const auto key = reader.read();
+				if ((key.isString() ? key.toString() : key.toVariant().toString()) == token) {
+					found = true;
+					break;
+				} else
+					reader.skip();
+			}
 			break;
 		default:
 			break;
 		}
+		if (!found)
+			throw DeserializationException{"No value found at JSON pointer: " + pointer.toUtf8()};
+	}
 
-		if(allowConvert && variant.canConvert(propertyType) && variant.convert(propertyType))
-			return variant;
-		else if(d->allowNull && value.isNull())
-			return QVariant{propertyType, nullptr};
-		else {
-			throw DeserializationException(QByteArray("Failed to convert deserialized variant of type ") +
-										   (vType ? vType : "<unknown>") +
-										   QByteArray(" to property type ") +
-										   QMetaType::typeName(propertyType) +
-										   QByteArray(". Make shure to register converters with the QJsonSerializer::register* methods"));
-		}
-	} else
-		return variant;
+	const auto traceHint = pointer.toUtf8();
+	return deserializeSubtypeFrom(propertyType, reader, parent, traceHint);
 }
 
 // ------------- private implementation -------------
@@ -437,17 +799,24 @@ QList<TypeConverterFactory*> SerializerBasePrivate::typeConverterFactories {
 
 	new TypeConverterStandardFactory<LegacyGeomConverter>{}
 };
+// must be defined after typeConverterFactories, to be initialized after it
+QAtomicInt SerializerBasePrivate::typeConverterFactoryCount = SerializerBasePrivate::typeConverterFactories.size();
 
-QSharedPointer<TypeConverter> SerializerBasePrivate::findSerConverter(int propertyType) const
+TypeConverter *SerializerBasePrivate::findSerConverter(int propertyType) const
 {
 	// first: update converters from factories
 	updateConverterStore();
 
-	// second: check if already cached
-	if (auto converter = serCache.get(propertyType); converter) {
-		qCDebug(logSerializer) << "Found cached serialization converter" << converter->name()
-							   << "for type:" <<  QMetaType::typeName(propertyType);
-		return converter;
+	// second: check if already cached (including known misses)
+	const auto generation = serCache.generation();
+	if (const auto slot = serCache.find(propertyType); slot) {
+		if (const auto converter = slot->converter.loadAcquire(); converter) {
+			if (converter == reinterpret_cast<TypeConverter*>(NoConverter))
+				return nullptr;
+			qCDebug(logSerializer) << "Found cached serialization converter" << converter->name()
+								   << "for type:" <<  QMetaType::typeName(propertyType);
+			return converter;
+		}
 	}
 
 	// third: check if the list of explicit converters has a matching one
@@ -457,18 +826,23 @@ QSharedPointer<TypeConverter> SerializerBasePrivate::findSerConverter(int proper
 			qCDebug(logSerializer) << "Found and cached serialization converter" << converter->name()
 								   << "for type:" <<  QMetaType::typeName(propertyType);
 			// add converter to cache and return it
-			serCache.add(propertyType, converter);
-			return converter;
+			serCache.update(propertyType, generation, [&](SerSlot &slot) {
+				slot.converter.storeRelease(converter.data());
+			});
+			return converter.data();
 		}
 	}
 
-	// fourth: no converter found: return default converter
+	// fourth: no converter found: remember the miss and return default converter
+	serCache.update(propertyType, generation, [](SerSlot &slot) {
+		slot.converter.storeRelease(reinterpret_cast<TypeConverter*>(NoConverter));
+	});
 	qCDebug(logSerializer) << "Unable to find serialization converte for type:" <<  QMetaType::typeName(propertyType)
 						   << "- falling back to default QVariant to CBOR conversion";
 	return nullptr;
 }
 
-QSharedPointer<TypeConverter> SerializerBasePrivate::findDeserConverter(int &propertyType, QCborTag tag, QCborValue::Type type) const
+TypeConverter *SerializerBasePrivate::findDeserConverter(int &propertyType, QCborTag tag, QCborValue::Type type) const
 {
 	Q_Q(const SerializerBase);
 	// first: update converters from factories
@@ -488,8 +862,7 @@ QSharedPointer<TypeConverter> SerializerBasePrivate::findDeserConverter(int &pro
 	}
 
 	// third: check if already cached
-	if (auto converter = deserCache.get(propertyType);
-		converter && converter->canDeserialize(propertyType, tag, type) > 0) {
+	if (const auto converter = findCachedDeserConverter(propertyType, tag, type); converter) {
 		qCDebug(logSerializer) << "Found cached deserialization converter" << converter->name()
 							   << "for type" <<  QMetaType::typeName(propertyType)
 							   << LogTag{tag}
@@ -498,6 +871,7 @@ QSharedPointer<TypeConverter> SerializerBasePrivate::findDeserConverter(int &pro
 	}
 
 	// fourth: check if the list of explicit converters has a matching one
+	const auto generation = deserCache.generation();
 	QReadLocker cLocker{&typeConverters.lock};
 	auto throwWrongTag = false;
 	std::optional<std::pair<QSharedPointer<TypeConverter>, int>> guessConverter;
@@ -519,12 +893,12 @@ QSharedPointer<TypeConverter> SerializerBasePrivate::findDeserConverter(int &pro
 			}
 
 			// add converter to cache (only happens for positive cases)
-			deserCache.add(propertyType, converter);
+			cacheDeserConverter(propertyType, generation, converter.data());
 			qCDebug(logSerializer) << "Found and cached deserialization converter" << converter->name()
 								   << "for type" <<  QMetaType::typeName(propertyType)
 								   << LogTag{tag}
 								   << "and CBOR-type" << type;
-			return converter;
+			return converter.data();
 		}
 	}
 	cLocker.unlock();
@@ -537,12 +911,12 @@ QSharedPointer<TypeConverter> SerializerBasePrivate::findDeserConverter(int &pro
 		if (converter) {
 			// add converter to list and cache
 			propertyType = newType;
-			deserCache.add(propertyType, converter);
+			cacheDeserConverter(propertyType, generation, converter.data());
 			qCDebug(logSerializer) << "Found and cached deserialization converter" << converter->name()
 								   << "by guessing the data with CBOR-tag" << tag
 								   << "and CBOR-type" << type
 								   << "is of type" << QMetaType::typeName(propertyType);
-			return converter;
+			return converter.data();
 		}
 	}
 
@@ -563,9 +937,58 @@ QSharedPointer<TypeConverter> SerializerBasePrivate::findDeserConverter(int &pro
 	return nullptr;
 }
 
+TypeConverter *SerializerBasePrivate::findCachedDeserConverter(int &propertyType, QCborTag tag, QCborValue::Type type) const
+{
+	const auto generation = deserCache.generation();
+	const auto slot = deserCache.find(propertyType);
+	if (!slot)
+		return nullptr;
+	const auto converter = slot->converter.loadAcquire();
+	if (!converter)
+		return nullptr;
+
+	// without a type, the converter guesses the type, which updates the propertyType
+	const auto key = propertyType != QMetaType::UnknownType ?
+		capabilityKey(tag, type) :
+		std::nullopt;
+	if (!key)
+		return converter->canDeserialize(propertyType, tag, type) > 0 ? converter : nullptr;
+
+	auto result = findCapability(*slot, *key);
+	// the memo is only valid if the converter was not replaced while reading it
+	if (result && slot->converter.loadAcquire() != converter)
+		result.reset();
+	if (!result) {
+		result = converter->canDeserialize(propertyType, tag, type);
+		deserCache.update(propertyType, generation, [&](DeserSlot &target) {
+			if (target.converter.loadRelaxed() == converter)
+				storeCapability(target, *key, *result);
+		});
+	}
+	return *result > 0 ? converter : nullptr;
+}
+
+void SerializerBasePrivate::cacheDeserConverter(int propertyType, quint32 generation, TypeConverter *converter) const
+{
+	// capabilities and converter are only ever changed under the table lock, so no memo of the
+	// previous converter can be stored for the new one
+	deserCache.update(propertyType, generation, [converter](DeserSlot &slot) {
+		if (slot.converter.loadRelaxed() == converter)
+			return;
+		// memoized capabilities belong to the previous converter
+		for (auto &capability : slot.capabilities)
+			capability.storeRelease(0);
+		slot.converter.storeRelease(converter);
+	});
+}
+
 void SerializerBasePrivate::updateConverterStore() const
 {
 	Q_Q(const SerializerBase);
+	// fast path: only touch the global lock if factories have been added since the last update
+	if (typeConverterFactoryCount.loadAcquire() <= typeConverters.factoryOffset.loadAcquire())
+		return;
+
 	QReadLocker fLocker{&typeConverterFactoryLock};
 	if (typeConverterFactories.size() > typeConverters.factoryOffset.loadAcquire()) {
 		QWriteLocker cLocker{&typeConverters.lock};
@@ -574,8 +997,7 @@ void SerializerBasePrivate::updateConverterStore() const
 			if (converter) {
 				converter->setHelper(q);
 				typeConverters.insertSorted(converter, cLocker);
-				serCache.clear();
-				deserCache.clear();
+				clearConverterCaches();
 				qCDebug(logSerializer) << "Found and added new global converter:" << converter->name();
 			}
 		}
@@ -583,13 +1005,209 @@ void SerializerBasePrivate::updateConverterStore() const
 	}
 }
 
+void SerializerBasePrivate::clearConverterCaches() const
+{
+	serCache.clear();
+	deserCache.clear();
+}
+
+bool SerializerBasePrivate::computeStaticPath(int metaTypeId, const SerializerSettings &settings) const
+{
+	Q_Q(const SerializerBase);
+	// the static path only reproduces the standard behaviour, so it cannot be used once anything customizes the types
+	const auto isPlainLeaf = [&](int typeId) {
+		auto cborType = QCborValue::Invalid;
+		switch (typeId) {
+		case QMetaType::Bool:
+			cborType = QCborValue::True;
+			break;
+		case QMetaType::Int:
+		case QMetaType::LongLong:
+			cborType = QCborValue::Integer;
+			break;
+		case QMetaType::Double:
+			cborType = QCborValue::Double;
+			break;
+		case QMetaType::QString:
+			cborType = QCborValue::String;
+			break;
+		default:
+			return false;
+		}
+		return q->typeTag(typeId) == TypeConverter::NoTag &&
+			   !findSerConverter(typeId) &&
+			   !findDeserConverter(typeId, TypeConverter::NoTag, cborType);
+	};
+
+	if (isPlainLeaf(metaTypeId))
+		return true;
+
+	// lists must be handled by the standard list converter, and contain plain leafs
+	const auto info = MetaWriters::SequentialWriter::getInfo(metaTypeId);
+	if (info.isSet || q->typeTag(metaTypeId) != TypeConverter::NoTag)
+		return false;
+	// numeric lists may have to be written as typed arrays, which only the converter does
+	if (!q->jsonMode() && settings.typedArrays &&
+		ListConverter::typedArrayTag(info.type) != TypeConverter::NoTag)
+		return false;
+	const auto converter = findSerConverter(metaTypeId);
+	return dynamic_cast<ListConverter*>(converter) &&
+		   findDeserConverter(metaTypeId, TypeConverter::NoTag, QCborValue::Array) == converter &&
+		   isPlainLeaf(info.type);
+}
+
+QSharedPointer<const SerializerSettings> SerializerBasePrivate::currentSettings() const
+{
+	QReadLocker rLocker{&settingsLock};
+	if (settingsCache)
+		return settingsCache;
+	rLocker.unlock();
+
+	QWriteLocker wLocker{&settingsLock};
+	if (!settingsCache) {
+		auto settings = QSharedPointer<SerializerSettings>::create();
+		fillSettings(*settings);
+		settingsCache = settings;
+	}
+	return settingsCache;
+}
+
+const SerializerSettings *SerializerBasePrivate::activeSettings() const
+{
+	return scopedSettings.owner == this ? scopedSettings.snapshot->data() : nullptr;
+}
+
+QSharedPointer<const SerializerSettings> SerializerBasePrivate::activeSnapshot() const
+{
+	if (scopedSettings.owner == this)
+		return *scopedSettings.snapshot;
+	else
+		return {};
+}
+
+
+
+SettingsScope::SettingsScope(const SerializerBasePrivate *d) :
+	_previousOwner{scopedSettings.owner},
+	_previousSnapshot{scopedSettings.snapshot}
+{
+	if (_previousOwner != d) {
+		_snapshot = d->currentSettings();
+		scopedSettings = {d, &_snapshot};
+	}
+	_settings = scopedSettings.snapshot->data();
+}
+
+SettingsScope::SettingsScope(const SerializerBasePrivate *d, const QSharedPointer<const SerializerSettings> &snapshot) :
+	_previousOwner{scopedSettings.owner},
+	_previousSnapshot{scopedSettings.snapshot}
+{
+	if (_previousOwner != d) {
+		_snapshot = snapshot;
+		scopedSettings = {d, &_snapshot};
+	}
+	_settings = scopedSettings.snapshot->data();
+}
+
+SettingsScope::~SettingsScope()
+{
+	scopedSettings = {_previousOwner, _previousSnapshot};
+}
+
+void SerializerBasePrivate::invalidateSettings()
+{
+	QWriteLocker _{&settingsLock};
+	settingsCache.reset();
+	// memoized deserialization capabilities depend on the settings
+	deserCache.clear();
+}
+
+void SerializerBasePrivate::fillSettings(SerializerSettings &settings) const
+{
+	settings.allowDefaultNull = allowNull;
+	settings.keepObjectName = keepObjectName;
+	settings.enumAsString = enumAsString;
+	settings.versionAsString = versionAsString;
+	settings.dateAsTimeStamp = dateAsTimeStamp;
+	settings.useBcp47Locale = useBcp47Locale;
+	settings.validationFlags = validationFlags;
+	settings.polymorphing = polymorphing;
+	settings.multiMapMode = multiMapMode;
+	settings.ignoreStoredAttribute = ignoreStoredAttribute;
+}
+
+QStringList SerializerBasePrivate::parseJsonPointer(const QString &pointer)
+{
+	// RFC 6901: the empty pointer references the whole document, every other one is a list of "/"-prefixed tokens
+	if (pointer.isEmpty())
+		return {};
+	if (!pointer.startsWith(QLatin1Char('/')))
+		throw DeserializationException{"Invalid JSON pointer, it must be empty or start with a \"/\": " + pointer.toUtf8()};
+
+	auto tokens = pointer.mid(1).split(QLatin1Char('/'));
+	for (auto &token : tokens) {
+		for (auto i = token.indexOf(QLatin1Char('~')); i != -1; i = token.indexOf(QLatin1Char('~'), i + 1)) {
+			if (i + 1 < token.size() && token[i + 1] == QLatin1Char('0'))
+				token.remove(i + 1, 1);
+			else if (i + 1 < token.size() && token[i + 1] == QLatin1Char('1'))
+				token.replace(i, 2, QLatin1Char('/'));
+			else
+				throw DeserializationException{"Invalid escape sequence in JSON pointer: " + pointer.toUtf8()};
+		}
+	}
+	return tokens;
+}
+
+// layout: valid bit (63) | result + 2 (56-58) | compact CBOR type (40-55) | tag (0-39)
+std::optional<quint64> SerializerBasePrivate::capabilityKey(QCborTag tag, QCborValue::Type type)
+{
+	constexpr quint64 TagMask = (Q_UINT64_C(1) << 40) - 1;
+	quint64 tagBits;
+	if (tag == TypeConverter::NoTag)
+		tagBits = TagMask;
+	else if (static_cast<quint64>(tag) < TagMask)
+		tagBits = static_cast<quint64>(tag);
+	else
+		return std::nullopt;
+
+	// all CBOR types fit into 16 bit, once the extended type bit is folded in
+	const auto rawType = static_cast<quint32>(type);
+	if (type == QCborValue::Invalid || (rawType & ~Q_UINT32_C(0x1FFFF)) != 0)
+		return std::nullopt;
+	const auto typeBits = static_cast<quint64>((rawType & 0xFFFF) | ((rawType >> 16) << 15));
+
+	return (Q_UINT64_C(1) << 63) | (typeBits << 40) | tagBits;
+}
+
+std::optional<TypeConverter::DeserializationCapabilityResult> SerializerBasePrivate::findCapability(const DeserSlot &slot, quint64 key)
+{
+	constexpr quint64 KeyMask = ~(Q_UINT64_C(0x7) << 56);
+	for (const auto &capability : slot.capabilities) {
+		const auto value = capability.loadAcquire();
+		if ((value & KeyMask) == key)
+			return static_cast<TypeConverter::DeserializationCapabilityResult>(static_cast<int>((value >> 56) & 0x7) - 2);
+	}
+	return std::nullopt;
+}
+
+void SerializerBasePrivate::storeCapability(DeserSlot &slot, quint64 key, TypeConverter::DeserializationCapabilityResult result)
+{
+	const auto value = key | (static_cast<quint64>(static_cast<int>(result) + 2) << 56);
+	for (auto &capability : slot.capabilities) {
+		if (capability.testAndSetOrdered(0, value))
+			return;
+	}
+	// all entries in use -> replace one of them
+	slot.capabilities[static_cast<std::size_t>(key ^ (key >> 40)) % slot.capabilities.size()].storeRelease(value);
+}
+
 int SerializerBasePrivate::getEnumId(QMetaEnum metaEnum, bool ser) const
 {
-	QByteArray eName = metaEnum.name();
-	if (const QByteArray scope = metaEnum.scope(); !scope.isEmpty())
-		eName = scope + "::" + eName;
-	const auto eTypeId = QMetaType::type(eName);
+	const auto eTypeId = PropertyPlan::enumTypeId(metaEnum);
 	if (eTypeId == QMetaType::UnknownType) {
+		QByteArray eName = metaEnum.name();
+		if (const QByteArray scope = metaEnum.scope(); !scope.isEmpty())
+			eName = scope + "::" + eName;
 		if (ser)
 			throw SerializationException{"Unable to determine typeid of meta enum " + eName};
 		else
@@ -761,7 +1379,8 @@ QVariant SerializerBasePrivate::deserializeJsonValue(int propertyType, const QCb
 			break;
 		case QMetaType::Float:
 		case QMetaType::Double:
-			if (!value.isDouble())
+			// integer literals are valid numbers as well
+			if (!value.isDouble() && !value.isInteger())
 				doThrow = true;
 			break;
 		default:
@@ -10,6 +10,8 @@
 
 #include <tuple>
 #include <optional>
+#include <functional>
+#include <iterator>
 #include <variant>
 
 #include <QtCore/qobject.h>
@@ -86,6 +88,9 @@ public:
 	};
 	Q_ENUM(MultiMapMode)
 
+	//! A function that yields the next element of a sequence to serialize, or std::nullopt once there are no more
+	using SequenceGenerator = std::function<std::optional<QVariant>()>;
+
 	//! Registers a custom extractor for the given type
 	template<typename TType, typename TExtractor>
 	static void registerExtractor();
@@ -212,16 +217,41 @@ protected:
 
 	// protected implementation -> internal use for the type converters
 	QVariant getProperty(const char *name) const override;
+	QSharedPointer<const SerializerSettings> settings() const override;
 	QSharedPointer<const TypeExtractor> extractor(int metaTypeId) const override;
 	QCborValue serializeSubtype(const QMetaProperty &property, const QVariant &value) const override;
+	QCborValue serializeSubtype(const QMetaProperty &property, int propertyType, const QVariant &value) const override;
 	QCborValue serializeSubtype(int propertyType, const QVariant &value, const QByteArray &traceHint) const override;
 	QVariant deserializeSubtype(const QMetaProperty &property, const QCborValue &value, QObject *parent) const override;
+	QVariant deserializeSubtype(const QMetaProperty &property, int propertyType, const QCborValue &value, QObject *parent) const override;
 	QVariant deserializeSubtype(int propertyType, const QCborValue &value, QObject *parent, const QByteArray &traceHint) const override;
+	void serializeSubtypeTo(const QMetaProperty &property, int propertyType, const QVariant &value, ValueWriter &writer) const override;
+	void serializeSubtypeTo(int propertyType, const QVariant &value, ValueWriter &writer, const QByteArray &traceHint) const override;
+	QVariant deserializeSubtypeFrom(const QMetaProperty &property, int propertyType, ValueReader &reader, QObject *parent) const override;
+	QVariant deserializeSubtypeFrom(int propertyType, ValueReader &reader, QObject *parent, const QByteArray &traceHint) const override;
+	QCborValue serializeSubtypeData(int propertyType, const void *data, const QByteArray &traceHint) const override;
+	void serializeSubtypeDataTo(int propertyType, const void *data, ValueWriter &writer, const QByteArray &traceHint) const override;
 
 	//! @private
 	QCborValue serializeVariant(int propertyType, const QVariant &value) const;
 	//! @private
+	void serializeVariantTo(int propertyType, const QVariant &value, ValueWriter &writer) const;
+	//! @private
+	QCborValue serializeData(int propertyType, const void *data) const;
+	//! @private
+	void serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const;
+	//! @private
+	void serializeSequenceVariantTo(int elementType, const SequenceGenerator &generator, ValueWriter &writer) const;
+	//! @private
 	QVariant deserializeVariant(int propertyType, const QCborValue &value, QObject *parent, bool skipConversion = false) const;
+	//! @private
+	void deserializeData(int propertyType, const QCborValue &value, void *data, QObject *parent) const;
+	//! @private
+	QVariant deserializeVariantFrom(int propertyType, ValueReader &reader, QObject *parent, bool skipConversion = false) const;
+	//! @private
+	bool hasStaticPath(int metaTypeId) const;
+	//! @private
+	QVariant deserializeVariantAt(int propertyType, const QString &pointer, ValueReader &reader, QObject *parent) const;
 
 private:
 	Q_DECLARE_PRIVATE(SerializerBase)
@@ -229,6 +259,40 @@ private:
 	static void registerInverseTypedefImpl(int typeId, const char *normalizedTypeName);
 };
 
+//! An immutable snapshot of the serializer settings, as seen by type converters
+struct SerializerSettings
+{
+	//! @readAcFn{SerializerBase::allowDefaultNull}
+	bool allowDefaultNull = false;
+	//! @readAcFn{SerializerBase::keepObjectName}
+	bool keepObjectName = false;
+	//! @readAcFn{SerializerBase::enumAsString}
+	bool enumAsString = false;
+	//! @readAcFn{SerializerBase::versionAsString}
+	bool versionAsString = false;
+	//! @readAcFn{SerializerBase::dateAsTimeStamp}
+	bool dateAsTimeStamp = false;
+	//! @readAcFn{SerializerBase::useBcp47Locale}
+	bool useBcp47Locale = true;
+	//! @readAcFn{SerializerBase::validationFlags}
+	SerializerBase::ValidationFlags validationFlags = SerializerBase::ValidationFlag::StandardValidation;
+	//! @readAcFn{SerializerBase::polymorphing}
+	SerializerBase::Polymorphing polymorphing = SerializerBase::Polymorphing::Enabled;
+	//! @readAcFn{SerializerBase::multiMapMode}
+	SerializerBase::MultiMapMode multiMapMode = SerializerBase::MultiMapMode::Map;
+	//! @readAcFn{SerializerBase::ignoreStoredAttribute}
+	bool ignoreStoredAttribute = false;
+
+	//! The value of JsonSerializer::byteArrayFormat, as integer (JSON only)
+	int byteArrayFormat = 0;
+	//! @readAcFn{JsonSerializer::validateBase64} (JSON only)
+	bool validateBase64 = true;
+	//! The explicitly assigned type tags (CBOR only)
+	QHash<int, QCborTag> typeTags;
+	//! @readAcFn{CborSerializer::typedArrays} (CBOR only)
+	bool typedArrays = false;
+};
+
 //! A macro the mark a class as polymorphic
 #define Q_JSON_POLYMORPHIC(x) \
 	static_assert(std::is_same<decltype(x), bool>::value, "x must be bool"); \
@@ -246,16 +310,22 @@ template<typename T>
 void SerializerBase::registerListConverters()
 {
 	MetaWriters::SequentialWriter::registerWriter<QList, T>();
+	MetaWriters::SequentialReader::registerReader<QList, T>();
 	MetaWriters::SequentialWriter::registerWriter<QLinkedList, T>();
+	MetaWriters::SequentialReader::registerReader<QLinkedList, T>();
 	MetaWriters::SequentialWriter::registerWriter<QVector, T>();
+	MetaWriters::SequentialReader::registerReader<QVector, T>();
 	MetaWriters::SequentialWriter::registerWriter<QStack, T>();
+	MetaWriters::SequentialReader::registerReader<QStack, T>();
 	MetaWriters::SequentialWriter::registerWriter<QQueue, T>();
+	MetaWriters::SequentialReader::registerReader<QQueue, T>();
 }
 
 template<typename T>
 void SerializerBase::registerSetConverters()
 {
 	MetaWriters::SequentialWriter::registerWriter<QSet, T>();
+	MetaWriters::SequentialReader::registerReader<QSet, T>();
 }
 
 template<typename TKey, typename TValue, bool mapTypes, bool hashTypes>
@@ -263,11 +333,15 @@ void SerializerBase::registerMapConverters()
 {
 	if constexpr (mapTypes) {
 		MetaWriters::AssociativeWriter::registerWriter<QMap, TKey, TValue>();
+		MetaWriters::AssociativeReader::registerReader<QMap, TKey, TValue>();
 		MetaWriters::AssociativeWriter::registerWriter<QMultiMap, TKey, TValue>();
+		MetaWriters::AssociativeReader::registerReader<QMultiMap, TKey, TValue>();
 	}
 	if constexpr (hashTypes) {
 		MetaWriters::AssociativeWriter::registerWriter<QHash, TKey, TValue>();
+		MetaWriters::AssociativeReader::registerReader<QHash, TKey, TValue>();
 		MetaWriters::AssociativeWriter::registerWriter<QMultiHash, TKey, TValue>();
+		MetaWriters::AssociativeReader::registerReader<QMultiHash, TKey, TValue>();
 	}
 }
 
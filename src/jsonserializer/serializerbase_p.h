@@ -4,8 +4,17 @@
 #include "qtjsonserializer_global.h"
 #include "serializerbase.h"
 
+#include <optional>
+#include <array>
+#include <vector>
+#include <memory>
+
 #include <QtCore/QReadWriteLock>
+#include <QtCore/QMutex>
 #include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QAtomicInteger>
 #include <QtCore/QLoggingCategory>
 
 #include <QtCore/private/qobject_p.h>
@@ -38,6 +47,62 @@ public:
 		QHash<int, QSharedPointer<TConverter>> _store;
 	};
 
+	template <typename TSlot>
+	class DispatchTable {
+		Q_DISABLE_COPY(DispatchTable)
+	public:
+		static constexpr int ChunkBits = 8;
+		static constexpr int ChunkSize = 1 << ChunkBits;
+
+		DispatchTable();
+
+		// returns nullptr if no slot was created for the type yet
+		inline const TSlot *find(int metaTypeId) const;
+		// must be read before computing a value that is stored via update()
+		inline quint32 generation() const;
+		// creates the slot if needed and passes it to fn, unless the table was cleared since generation was read
+		template <typename TFunc>
+		bool update(int metaTypeId, quint32 generation, const TFunc &fn);
+		void clear();
+
+	private:
+		struct Chunk {
+			std::array<TSlot, ChunkSize> slots {};
+		};
+		struct Table {
+			QVector<Chunk*> chunks;
+		};
+
+		QAtomicPointer<const Table> _table;
+		QAtomicInteger<quint32> _generation = 0;
+		QMutex _writeLock;
+		// chunks are reset in place when clearing, so only growing the table allocates.
+		// Replaced tables are kept, as readers might still hold them, but there is at most one per chunk
+		std::vector<std::unique_ptr<const Table>> _tables;
+		std::vector<std::unique_ptr<Chunk>> _chunks;
+	};
+
+	enum StaticPathState : int {
+		StaticPathUnknown = 0,
+		StaticPathDisabled,
+		StaticPathEnabled
+	};
+
+	struct SerSlot {
+		QAtomicPointer<TypeConverter> converter;
+
+		inline void reset();
+	};
+	struct DeserSlot {
+		QAtomicPointer<TypeConverter> converter;
+		// memoized canDeserialize() results of the converter, see capabilityKey()
+		std::array<QAtomicInteger<quint64>, 4> capabilities {};
+		// memoized hasStaticPath() result for the type
+		QAtomicInt staticPath = StaticPathUnknown;
+
+		inline void reset();
+	};
+
 	template <typename TConverter>
 	struct ConverterStore {
 		mutable QReadWriteLock lock {};
@@ -51,10 +116,14 @@ public:
 		void insertSorted(const QSharedPointer<TConverter> &converter, QWriteLocker &locker);
 	};
 
+	// pointers are at least 2-byte aligned, so 1 can never be a real converter
+	static constexpr quintptr NoConverter = 1;
+
 	static ThreadSafeStore<TypeExtractor> extractors;
 
 	static QReadWriteLock typeConverterFactoryLock;
 	static QList<TypeConverterFactory*> typeConverterFactories;
+	static QAtomicInt typeConverterFactoryCount;
 
 	bool allowNull = false;
 	bool keepObjectName = false;
@@ -67,16 +136,33 @@ public:
 	MultiMapMode multiMapMode = MultiMapMode::Map;
 	bool ignoreStoredAttribute = false;
 
+	mutable QReadWriteLock settingsLock {};
+	mutable QSharedPointer<const SerializerSettings> settingsCache;
+
 	mutable ConverterStore<TypeConverter> typeConverters;
-	mutable ThreadSafeStore<TypeConverter> serCache;
-	mutable ThreadSafeStore<TypeConverter> deserCache;
+	mutable DispatchTable<SerSlot> serCache;
+	mutable DispatchTable<DeserSlot> deserCache;
 
 	template <typename TConverter>
 	void insertSorted(const QSharedPointer<TConverter> &converter, QList<QSharedPointer<TConverter>> &list) const;
 
-	QSharedPointer<TypeConverter> findSerConverter(int propertyType) const;
-	QSharedPointer<TypeConverter> findDeserConverter(int &propertyType, QCborTag tag, QCborValue::Type type) const;
+	TypeConverter *findSerConverter(int propertyType) const;
+	TypeConverter *findDeserConverter(int &propertyType, QCborTag tag, QCborValue::Type type) const;
+	TypeConverter *findCachedDeserConverter(int &propertyType, QCborTag tag, QCborValue::Type type) const;
+	void cacheDeserConverter(int propertyType, quint32 generation, TypeConverter *converter) const;
 	void updateConverterStore() const;
+	void clearConverterCaches() const;
+	bool computeStaticPath(int metaTypeId, const SerializerSettings &settings) const;
+	static QStringList parseJsonPointer(const QString &pointer);
+	static std::optional<quint64> capabilityKey(QCborTag tag, QCborValue::Type type);
+	static std::optional<TypeConverter::DeserializationCapabilityResult> findCapability(const DeserSlot &slot, quint64 key);
+	static void storeCapability(DeserSlot &slot, quint64 key, TypeConverter::DeserializationCapabilityResult result);
+
+	QSharedPointer<const SerializerSettings> currentSettings() const;
+	const SerializerSettings *activeSettings() const;
+	QSharedPointer<const SerializerSettings> activeSnapshot() const;
+	void invalidateSettings();
+	virtual void fillSettings(SerializerSettings &settings) const;
 
 	int getEnumId(QMetaEnum metaEnum, bool ser) const;
 	virtual QCborValue serializeValue(int propertyType, const QVariant &value) const;
@@ -84,6 +170,27 @@ public:
 	virtual QVariant deserializeJsonValue(int propertyType, const QCborValue &value) const;
 };
 
+// captures the settings once per top level de/serialization
+class Q_JSONSERIALIZER_EXPORT SettingsScope
+{
+	Q_DISABLE_COPY(SettingsScope)
+public:
+	explicit SettingsScope(const SerializerBasePrivate *d);
+	// activates the given snapshot instead of the current settings, unless a scope of d is already active
+	SettingsScope(const SerializerBasePrivate *d, const QSharedPointer<const SerializerSettings> &snapshot);
+	~SettingsScope();
+
+	inline const SerializerSettings *operator->() const {
+		return _settings;
+	}
+
+private:
+	const SerializerBasePrivate *_previousOwner;
+	const QSharedPointer<const SerializerSettings> *_previousSnapshot;
+	QSharedPointer<const SerializerSettings> _snapshot;
+	const SerializerSettings *_settings;
+};
+
 Q_DECLARE_LOGGING_CATEGORY(logSerializer)
 Q_DECLARE_LOGGING_CATEGORY(logSerializerExtractor)
 
@@ -113,6 +220,93 @@ void SerializerBasePrivate::ThreadSafeStore<TConverter>::clear()
 	_store.clear();
 }
 
+template<typename TSlot>
+SerializerBasePrivate::DispatchTable<TSlot>::DispatchTable()
+{
+	auto table = new Table{};
+	_tables.emplace_back(table);
+	_table.storeRelease(table);
+}
+
+template<typename TSlot>
+const TSlot *SerializerBasePrivate::DispatchTable<TSlot>::find(int metaTypeId) const
+{
+	if (metaTypeId < 0)
+		return nullptr;
+	const auto table = _table.loadAcquire();
+	const auto chunkIndex = metaTypeId >> ChunkBits;
+	if (chunkIndex >= table->chunks.size())
+		return nullptr;
+	const auto chunk = table->chunks[chunkIndex];
+	if (!chunk)
+		return nullptr;
+	return &chunk->slots[static_cast<std::size_t>(metaTypeId & (ChunkSize - 1))];
+}
+
+template<typename TSlot>
+quint32 SerializerBasePrivate::DispatchTable<TSlot>::generation() const
+{
+	return _generation.loadAcquire();
+}
+
+template<typename TSlot>
+template<typename TFunc>
+bool SerializerBasePrivate::DispatchTable<TSlot>::update(int metaTypeId, quint32 generation, const TFunc &fn)
+{
+	if (metaTypeId < 0)
+		return false;
+	const auto chunkIndex = metaTypeId >> ChunkBits;
+	const auto slotIndex = static_cast<std::size_t>(metaTypeId & (ChunkSize - 1));
+
+	QMutexLocker _{&_writeLock};
+	// values computed before the last clear are outdated
+	if (generation != _generation.loadRelaxed())
+		return false;
+
+	const auto table = _table.loadAcquire();
+	// fast path: the chunk already exists -> slots are atomic and updated in place
+	if (chunkIndex < table->chunks.size() && table->chunks[chunkIndex]) {
+		fn(table->chunks[chunkIndex]->slots[slotIndex]);
+		return true;
+	}
+
+	// slow path: publish a copy of the table with the new chunk
+	auto chunk = new Chunk{};
+	_chunks.emplace_back(chunk);
+	auto newTable = new Table{table->chunks};
+	_tables.emplace_back(newTable);
+	if (newTable->chunks.size() <= chunkIndex)
+		newTable->chunks.resize(chunkIndex + 1);
+	newTable->chunks[chunkIndex] = chunk;
+	fn(chunk->slots[slotIndex]);
+	_table.storeRelease(newTable);
+	return true;
+}
+
+template<typename TSlot>
+void SerializerBasePrivate::DispatchTable<TSlot>::clear()
+{
+	QMutexLocker _{&_writeLock};
+	_generation.fetchAndAddRelease(1);
+	for (const auto &chunk : _chunks) {
+		for (auto &slot : chunk->slots)
+			slot.reset();
+	}
+}
+
+void SerializerBasePrivate::SerSlot::reset()
+{
+	converter.storeRelease(nullptr);
+}
+
+void SerializerBasePrivate::DeserSlot::reset()
+{
+	for (auto &capability : capabilities)
+		capability.storeRelease(0);
+	staticPath.storeRelease(StaticPathUnknown);
+	converter.storeRelease(nullptr);
+}
+
 template<typename TConverter>
 SerializerBasePrivate::ConverterStore<TConverter>::ConverterStore(std::initializer_list<QSharedPointer<TConverter>> initData)
 	: store{std::move(initData)}
@@ -57,8 +57,7 @@ int TypeConverter::guessType(QCborTag tag, QCborValue::Type dataType) const
 TypeConverter::DeserializationCapabilityResult TypeConverter::canDeserialize(int &metaTypeId, QCborTag tag, QCborValue::Type dataType) const
 {
 	const auto asJson = helper()->jsonMode();
-	const auto strict = helper()->getProperty("validationFlags")
-							.value<SerializerBase::ValidationFlags>()
+	const auto strict = helper()->settings()->validationFlags
 							.testFlag(SerializerBase::ValidationFlag::StrictBasicTypes);
 
 	// case A: a metaTypeId is present
@@ -108,11 +107,45 @@ TypeConverter::DeserializationCapabilityResult TypeConverter::canDeserialize(int
 		return DeserializationCapabilityResult::Negative;
 }
 
+void TypeConverter::serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	writer.append(serialize(propertyType, value));
+}
+
 QVariant TypeConverter::deserializeJson(int propertyType, const QCborValue &value, QObject *parent) const
 {
 	return deserializeCbor(propertyType, value, parent);
 }
 
+QVariant TypeConverter::deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const
+{
+	const auto value = reader.read();
+	if (helper()->jsonMode())
+		return deserializeJson(propertyType, value, parent);
+	else
+		return deserializeCbor(propertyType, value, parent);
+}
+
+QCborValue TypeConverter::serializeData(int propertyType, const void *data) const
+{
+	return serialize(propertyType, QVariant{propertyType, data});
+}
+
+void TypeConverter::serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const
+{
+	serializeTo(propertyType, QVariant{propertyType, data}, writer);
+}
+
+bool TypeConverter::deserializeInto(int propertyType, const QCborValue &value, void *data, QObject *parent) const
+{
+	Q_UNUSED(propertyType)
+	Q_UNUSED(value)
+	Q_UNUSED(data)
+	Q_UNUSED(parent)
+	// the serializer falls back to deserializeCbor/deserializeJson and assigns the result
+	return false;
+}
+
 void TypeConverter::mapTypesToJson(QList<QCborValue::Type> &typeList) const
 {
 	for (auto &type : typeList) {
@@ -131,6 +164,9 @@ void TypeConverter::mapTypesToJson(QList<QCborValue::Type> &typeList) const
 			break;
 		}
 	}
+	// JSON numbers have no type, integer literals are read as integers and all others as doubles
+	if (typeList.contains(QCborValue::Double) && !typeList.contains(QCborValue::Integer))
+		typeList.append(QCborValue::Integer);
 }
 
 
@@ -139,6 +175,76 @@ TypeConverter::SerializationHelper::SerializationHelper() = default;
 
 TypeConverter::SerializationHelper::~SerializationHelper() = default;
 
+QSharedPointer<const SerializerSettings> TypeConverter::SerializationHelper::settings() const
+{
+	// helpers without a snapshot of their own provide the settings as properties
+	auto settings = QSharedPointer<SerializerSettings>::create();
+	const auto value = [this](const char *name, auto &target) {
+		if (const auto property = getProperty(name); property.isValid())
+			target = property.value<std::decay_t<decltype(target)>>();
+	};
+	value("allowDefaultNull", settings->allowDefaultNull);
+	value("keepObjectName", settings->keepObjectName);
+	value("enumAsString", settings->enumAsString);
+	value("versionAsString", settings->versionAsString);
+	value("dateAsTimeStamp", settings->dateAsTimeStamp);
+	value("useBcp47Locale", settings->useBcp47Locale);
+	value("validationFlags", settings->validationFlags);
+	value("polymorphing", settings->polymorphing);
+	value("multiMapMode", settings->multiMapMode);
+	value("ignoreStoredAttribute", settings->ignoreStoredAttribute);
+	if (const auto format = getProperty("byteArrayFormat"); format.isValid())
+		settings->byteArrayFormat = format.toInt();
+	value("validateBase64", settings->validateBase64);
+	value("typedArrays", settings->typedArrays);
+	return settings;
+}
+
+QCborValue TypeConverter::SerializationHelper::serializeSubtype(const QMetaProperty &property, int propertyType, const QVariant &value) const
+{
+	Q_UNUSED(propertyType)
+	return serializeSubtype(property, value);
+}
+
+QVariant TypeConverter::SerializationHelper::deserializeSubtype(const QMetaProperty &property, int propertyType, const QCborValue &value, QObject *parent) const
+{
+	Q_UNUSED(propertyType)
+	return deserializeSubtype(property, value, parent);
+}
+
+void TypeConverter::SerializationHelper::serializeSubtypeTo(const QMetaProperty &property, int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	writer.append(serializeSubtype(property, propertyType, value));
+}
+
+void TypeConverter::SerializationHelper::serializeSubtypeTo(int propertyType, const QVariant &value, ValueWriter &writer, const QByteArray &traceHint) const
+{
+	writer.append(serializeSubtype(propertyType, value, traceHint));
+}
+
+QVariant TypeConverter::SerializationHelper::deserializeSubtypeFrom(const QMetaProperty &property, int propertyType, ValueReader &reader, QObject *parent) const
+{
+	return deserializeSubtype(property, propertyType, reader.read(), parent);
+}
+
+QVariant TypeConverter::SerializationHelper::deserializeSubtypeFrom(int propertyType, ValueReader &reader, QObject *parent, const QByteArray &traceHint) const
+{
+	return deserializeSubtype(propertyType, reader.read(), parent, traceHint);
+}
+
+QCborValue TypeConverter::SerializationHelper::serializeSubtypeData(int propertyType, const void *data, const QByteArray &traceHint) const
+{
+	if (propertyType == QMetaType::UnknownType)
+		return serializeSubtype(propertyType, *static_cast<const QVariant*>(data), traceHint);
+	else
+		return serializeSubtype(propertyType, QVariant{propertyType, data}, traceHint);
+}
+
+void TypeConverter::SerializationHelper::serializeSubtypeDataTo(int propertyType, const void *data, ValueWriter &writer, const QByteArray &traceHint) const
+{
+	writer.append(serializeSubtypeData(propertyType, data, traceHint));
+}
+
 
 
 TypeConverterFactory::TypeConverterFactory() = default;
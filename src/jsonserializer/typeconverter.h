@@ -2,6 +2,8 @@
 #define QTJSONSERIALIZER_TYPECONVERTER_H
 
 #include "QtJsonSerializer/qtjsonserializer_global.h"
+#include "QtJsonSerializer/valuewriter.h"
+#include "QtJsonSerializer/valuereader.h"
 
 #include <type_traits>
 #include <limits>
@@ -34,6 +36,8 @@ public:
 	virtual void emplace(QVariant &target, const QVariant &value, int index = -1) const = 0;
 };
 
+struct SerializerSettings;
+
 class TypeConverterPrivate;
 //! An interface to create custom serializer type converters
 class Q_JSONSERIALIZER_EXPORT TypeConverter
@@ -74,6 +78,8 @@ public:
 		virtual bool jsonMode() const = 0;
 		//! Returns a property from the serializer
 		virtual QVariant getProperty(const char *name) const = 0;
+		//! Returns the typed settings of the serializer, captured for the current de/serialization
+		virtual QSharedPointer<const SerializerSettings> settings() const;
 		//! Returns a tag registered for the given metaTypeId
 		virtual QCborTag typeTag(int metaTypeId) const = 0;
 		//! Returns a reference to an extractor for the given type, or nullptr
@@ -87,6 +93,25 @@ public:
 		virtual QVariant deserializeSubtype(const QMetaProperty &property, const QCborValue &value, QObject *parent) const = 0;
 		//! Deserialize a subvalue, represented by a type id
 		virtual QVariant deserializeSubtype(int propertyType, const QCborValue &value, QObject *parent, const QByteArray &traceHint = {}) const = 0;
+
+		//! Serialize a subvalue, represented by a meta property with an already resolved type id
+		virtual QCborValue serializeSubtype(const QMetaProperty &property, int propertyType, const QVariant &value) const;
+		//! Deserialize a subvalue, represented by a meta property with an already resolved type id
+		virtual QVariant deserializeSubtype(const QMetaProperty &property, int propertyType, const QCborValue &value, QObject *parent) const;
+
+		//! Serialize a subvalue, represented by a meta property with an already resolved type id, into a writer
+		virtual void serializeSubtypeTo(const QMetaProperty &property, int propertyType, const QVariant &value, ValueWriter &writer) const;
+		//! Serialize a subvalue, represented by a type id, into a writer
+		virtual void serializeSubtypeTo(int propertyType, const QVariant &value, ValueWriter &writer, const QByteArray &traceHint = {}) const;
+		//! Deserialize a subvalue, represented by a meta property with an already resolved type id, from a reader
+		virtual QVariant deserializeSubtypeFrom(const QMetaProperty &property, int propertyType, ValueReader &reader, QObject *parent) const;
+		//! Deserialize a subvalue, represented by a type id, from a reader
+		virtual QVariant deserializeSubtypeFrom(int propertyType, ValueReader &reader, QObject *parent, const QByteArray &traceHint = {}) const;
+
+		//! Serialize a subvalue from a pointer to it, represented by a type id. For QMetaType::UnknownType, data points to a QVariant
+		virtual QCborValue serializeSubtypeData(int propertyType, const void *data, const QByteArray &traceHint = {}) const;
+		//! Serialize a subvalue from a pointer to it, represented by a type id, into a writer. For QMetaType::UnknownType, data points to a QVariant
+		virtual void serializeSubtypeDataTo(int propertyType, const void *data, ValueWriter &writer, const QByteArray &traceHint = {}) const;
 	};
 
 	//! Constructor
@@ -122,10 +147,20 @@ public:
 
 	//! Called by the serializer to serializer your given type to CBOR
 	virtual QCborValue serialize(int propertyType, const QVariant &value) const = 0;
+	//! Called by the serializer to serialize your given type directly into a writer
+	virtual void serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const;
 	//! Called by the serializer to deserializer your given type from CBOR
 	virtual QVariant deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const = 0;
 	//! Called by the serializer to deserializer your given type from JSON
 	virtual QVariant deserializeJson(int propertyType, const QCborValue &value, QObject *parent) const;
+	//! Called by the serializer to deserialize your given type directly from a reader
+	virtual QVariant deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const;
+	//! Called by the serializer to serialize your given type from a pointer to an instance of it
+	virtual QCborValue serializeData(int propertyType, const void *data) const;
+	//! Called by the serializer to serialize your given type from a pointer to an instance of it directly into a writer
+	virtual void serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const;
+	//! Called by the serializer to deserialize your given type into existing storage of that type, if supported
+	virtual bool deserializeInto(int propertyType, const QCborValue &value, void *data, QObject *parent) const;
 
 private:
 	QScopedPointer<TypeConverterPrivate> d;
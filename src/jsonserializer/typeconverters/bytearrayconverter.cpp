@@ -1,6 +1,7 @@
 #include "bytearrayconverter_p.h"
 #include "exception.h"
 #include "jsonserializer.h"
+#include "valuereader_p.h"
 
 #include <QtCore/QByteArray>
 #include <QtCore/QRegularExpression>
@@ -61,9 +62,9 @@ QVariant BytearrayConverter::deserializeJson(int propertyType, const QCborValue
 	Q_UNUSED(propertyType)
 	Q_UNUSED(parent)
 
-	const auto mode = helper()->getProperty("byteArrayFormat").value<JsonSerializer::ByteArrayFormat>();
+	const auto mode = static_cast<JsonSerializer::ByteArrayFormat>(helper()->settings()->byteArrayFormat);
 	const auto strValue = value.toString();
-	if (helper()->getProperty("validateBase64").toBool()) {
+	if (helper()->settings()->validateBase64) {
 		switch (mode) {
 		case JsonSerializer::ByteArrayFormat::Base64: {
 			if ((strValue.size() % 4) != 0)
@@ -103,3 +104,13 @@ QVariant BytearrayConverter::deserializeJson(int propertyType, const QCborValue
 		Q_UNREACHABLE();
 	}
 }
+
+QVariant BytearrayConverter::deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const
+{
+	// byte strings of mapped data are passed on as reference, instead of being copied
+	if (const auto cborReader = dynamic_cast<CborValueReader*>(&reader); cborReader) {
+		if (auto bytes = cborReader->takeRawByteArray(); bytes)
+			return *std::move(bytes);
+	}
+	return TypeConverter::deserializeFrom(propertyType, reader, parent);
+}
@@ -17,6 +17,7 @@ public:
 	QCborValue serialize(int propertyType, const QVariant &value) const override;
 	QVariant deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const override;
 	QVariant deserializeJson(int propertyType, const QCborValue &value, QObject *parent) const override;
+	QVariant deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const override;
 };
 
 }
@@ -80,7 +80,7 @@ QCborValue DateTimeConverter::serialize(int propertyType, const QVariant &value)
 {
 	switch (propertyType) {
 	case QMetaType::QDateTime:
-		if (helper()->getProperty("dateAsTimeStamp").toBool())
+		if (helper()->settings()->dateAsTimeStamp)
 			return {QCborKnownTags::UnixTime_t, value.toDateTime().toUTC().toSecsSinceEpoch()};
 		else
 			return QCborValue{value.toDateTime()};
@@ -49,7 +49,7 @@ QCborValue EnumConverter::serialize(int propertyType, const QVariant &value) con
 {
 	const auto metaEnum = getEnum(propertyType, true);
 	const auto tag = static_cast<QCborTag>(metaEnum.isFlag() ? CborSerializer::Flags : CborSerializer::Enum);
-	if (helper()->getProperty("enumAsString").toBool()) {
+	if (helper()->settings()->enumAsString) {
 		if (metaEnum.isFlag())
 			return {tag, QString::fromUtf8(metaEnum.valueToKeys(value.toInt()))};
 		else
@@ -1,9 +1,12 @@
 #include "gadgetconverter_p.h"
 #include "exception.h"
 #include "serializerbase_p.h"
+#include "propertyplan_p.h"
+#include "cbormapbuilder_p.h"
 
 #include <QtCore/QMetaProperty>
 #include <QtCore/QSet>
+#include <QtCore/QBitArray>
 using namespace QtJsonSerializer;
 using namespace QtJsonSerializer::TypeConverters;
 
@@ -33,61 +36,176 @@ QList<QCborValue::Type> GadgetConverter::allowedCborTypes(int metaTypeId, QCborT
 }
 
 QCborValue GadgetConverter::serialize(int propertyType, const QVariant &value) const
+{
+	auto gValue = value;
+	return serializeData(propertyType, gadgetData(propertyType, gValue));
+}
+
+void GadgetConverter::serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const
 {
 	const auto metaObject = QMetaType::metaObjectForType(propertyType);
 	if (!metaObject)
 		throw SerializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
-	const auto isPtr = QMetaType::typeFlags(propertyType).testFlag(QMetaType::PointerToGadget);
 
 	auto gValue = value;
-	if (!gValue.convert(propertyType))
+	const auto gadget = gadgetAddress(propertyType, gadgetData(propertyType, gValue));
+	if (!gadget) {
+		writer.append(QCborValue::Null);
+		return;
+	}
+
+	const auto plan = PropertyPlan::get(metaObject, 0, helper()->settings()->ignoreStoredAttribute);
+	const auto &properties = plan->properties();
+	writer.startMap(properties.size());
+	for (const auto &info : properties) {
+		writer.append(info.key);
+		helper()->serializeSubtypeTo(info.property, info.typeId, info.property.readOnGadget(gadget), writer);
+	}
+	writer.endMap();
+}
+
+QVariant GadgetConverter::deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const
+{
+	Q_UNUSED(parent)  // gadgets neither have nor serve as parent
+	const auto metaObject = gadgetMetaObject(propertyType);
+
+	auto cValue = value.isTag() ? value.taggedValue() : value;
+	if (cValue.isNull()) {
+		if (QMetaType::typeFlags(propertyType).testFlag(QMetaType::PointerToGadget))
+			return QVariant{propertyType, nullptr};  // initialize an empty (nullptr) variant
+		else
+			return QVariant{};  // return to allow default null for gadgets. If not allowed, this will fail, as a null variant cannot be converted to a gadget
+	}
+
+	QVariant gadget;
+	const auto gadgetPtr = createGadget(propertyType, metaObject, gadget);
+	deserializeProperties(metaObject, cValue.toMap(), gadgetPtr);
+	return gadget;
+}
+
+QVariant GadgetConverter::deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const
+{
+	Q_UNUSED(parent)  // gadgets neither have nor serve as parent
+	const auto metaObject = gadgetMetaObject(propertyType);
+
+	// null gadgets are never streamed, so the map can always be read into a new gadget
+	QVariant gadget;
+	const auto gadgetPtr = createGadget(propertyType, metaObject, gadget);
+
+	const auto settings = helper()->settings();
+	const auto validationFlags = settings->validationFlags;
+	const auto plan = PropertyPlan::get(metaObject, 0, settings->ignoreStoredAttribute);
+
+	// track required properties, if set
+	const auto checkRequired = validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties);
+	QBitArray foundProps{checkRequired ? plan->requiredKeys().size() : 0};
+
+	// now deserialize all properties, directly from the stream
+	reader.enterContainer();
+	while (reader.hasNext()) {
+		const auto key = reader.read().toString();
+		if (const auto info = plan->find(key); info) {
+			info->property.writeOnGadget(gadgetPtr, helper()->deserializeSubtypeFrom(info->property, info->typeId, reader, nullptr));
+			if (checkRequired && info->requiredIndex != -1)
+				foundProps.setBit(info->requiredIndex);
+		} else if (validationFlags.testFlag(SerializerBase::ValidationFlag::NoExtraProperties)) {
+			throw DeserializationException("Found extra property " +
+												key.toUtf8() +
+												" but extra properties are not allowed");
+		} else
+			reader.read();  // skip the value of the unknown property
+	}
+	reader.leaveContainer();
+
+	if (checkRequired)
+		verifyRequiredProperties(metaObject, plan->requiredKeys(), foundProps);
+	return gadget;
+}
+
+QCborValue GadgetConverter::serializeData(int propertyType, const void *data) const
+{
+	const auto metaObject = QMetaType::metaObjectForType(propertyType);
+	if (!metaObject)
+		throw SerializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
+
+	const auto gadget = gadgetAddress(propertyType, data);
+	if (!gadget)
+		return QCborValue::Null;
+
+	//go through all properties and try to serialize them
+	const auto plan = PropertyPlan::get(metaObject, 0, helper()->settings()->ignoreStoredAttribute);
+	CborMapBuilder cborMap{plan->properties().size()};
+	for (const auto &info : plan->properties())
+		cborMap.append(info.key, helper()->serializeSubtype(info.property, info.typeId, info.property.readOnGadget(gadget)));
+
+	return cborMap.take();
+}
+
+bool GadgetConverter::deserializeInto(int propertyType, const QCborValue &value, void *data, QObject *parent) const
+{
+	Q_UNUSED(parent)  // gadgets neither have nor serve as parent
+	// null values are left to the serializer, as they depend on the default null handling
+	const auto cValue = value.isTag() ? value.taggedValue() : value;
+	if (cValue.isNull())
+		return false;
+
+	const auto metaObject = gadgetMetaObject(propertyType);
+	auto gadgetPtr = data;
+	if (QMetaType::typeFlags(propertyType).testFlag(QMetaType::PointerToGadget)) {
+		// existing gadgets are reused, only null pointers get a new one
+		auto &pointer = *static_cast<void**>(data);
+		if (!pointer) {
+			QVariant holder;
+			pointer = createGadget(propertyType, metaObject, holder);
+		}
+		gadgetPtr = pointer;
+	}
+
+	deserializeProperties(metaObject, cValue.toMap(), gadgetPtr);
+	return true;
+}
+
+const void *GadgetConverter::gadgetData(int propertyType, QVariant &value) const
+{
+	if (!value.convert(propertyType))
 		throw SerializationException(QByteArray("Data is not of the required gadget type ") + QMetaType::typeName(propertyType));
+	return value.constData();
+}
+
+const void *GadgetConverter::gadgetAddress(int propertyType, const void *data) const
+{
+	const auto isPtr = QMetaType::typeFlags(propertyType).testFlag(QMetaType::PointerToGadget);
 	const void *gadget = nullptr;
 	if (isPtr) {
 		// with pointers, null gadgets are allowed
-		gadget = *reinterpret_cast<const void* const *>(gValue.constData());
+		gadget = *static_cast<const void* const *>(data);
 		if (!gadget)
-			return QCborValue::Null;
+			return nullptr;
 	} else
-		gadget = gValue.constData();
+		gadget = data;
 	if (!gadget)
 		throw SerializationException(QByteArray("Unable to get address of gadget ") + QMetaType::typeName(propertyType));
-
-	QCborMap cborMap;
-	//go through all properties and try to serialize them
-	const auto ignoreStoredAttribute = helper()->getProperty("ignoreStoredAttribute").toBool();
-	for (auto i = 0; i < metaObject->propertyCount(); i++) {
-		auto property = metaObject->property(i);
-		if (ignoreStoredAttribute || property.isStored())
-			cborMap[QString::fromUtf8(property.name())] = helper()->serializeSubtype(property, property.readOnGadget(gadget));
-	}
-
-	return cborMap;
+	return gadget;
 }
 
-QVariant GadgetConverter::deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const
+const QMetaObject *GadgetConverter::gadgetMetaObject(int propertyType) const
 {
-	Q_UNUSED(parent)  // gadgets neither have nor serve as parent
-	const auto isPtr = QMetaType::typeFlags(propertyType).testFlag(QMetaType::PointerToGadget);
-
-	auto metaObject = QMetaType::metaObjectForType(propertyType);
+	const auto metaObject = QMetaType::metaObjectForType(propertyType);
 	if (!metaObject)
 		throw DeserializationException(QByteArray("Unable to get metaobject for gadget type") + QMetaType::typeName(propertyType));
+	return metaObject;
+}
 
-	auto cValue = value.isTag() ? value.taggedValue() : value;
-	QVariant gadget;
+void *GadgetConverter::createGadget(int propertyType, const QMetaObject *metaObject, QVariant &gadget) const
+{
 	void *gadgetPtr = nullptr;
-	if (isPtr) {
-		if (cValue.isNull())
-			return QVariant{propertyType, nullptr};  // initialize an empty (nullptr) variant
+	if (QMetaType::typeFlags(propertyType).testFlag(QMetaType::PointerToGadget)) {
 		const auto gadgetType = QMetaType::type(metaObject->className());
 		if (gadgetType == QMetaType::UnknownType)
 			throw DeserializationException(QByteArray("Unable to get type of gadget from gadget-pointer type") + QMetaType::typeName(propertyType));
 		gadgetPtr = QMetaType::create(gadgetType);
 		gadget = QVariant{propertyType, &gadgetPtr};
 	} else {
-		if (cValue.isNull())
-			return QVariant{};  // return to allow default null for gadgets. If not allowed, this will fail, as a null variant cannot be converted to a gadget
 		gadget = QVariant{propertyType, nullptr};
 		gadgetPtr = gadget.data();
 	}
@@ -97,43 +215,49 @@ QVariant GadgetConverter::deserializeCbor(int propertyType, const QCborValue &va
 											QMetaType::typeName(propertyType) +
 											QByteArray(". Does it have a default constructor?"));
 	}
+	return gadgetPtr;
+}
 
-	const auto validationFlags = helper()->getProperty("validationFlags").value<SerializerBase::ValidationFlags>();
-	const auto ignoreStoredAttribute = helper()->getProperty("ignoreStoredAttribute").toBool();
+void GadgetConverter::deserializeProperties(const QMetaObject *metaObject, const QCborMap &cborMap, void *gadgetPtr) const
+{
+	const auto settings = helper()->settings();
+	const auto validationFlags = settings->validationFlags;
+	const auto plan = PropertyPlan::get(metaObject, 0, settings->ignoreStoredAttribute);
 
-	// collect required properties, if set
-	QSet<QByteArray> reqProps;
-	if (validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties)) {
-		for (auto i = 0; i < metaObject->propertyCount(); i++) {
-			auto property = metaObject->property(i);
-			if (ignoreStoredAttribute || property.isStored())
-				reqProps.insert(property.name());
-		}
-	}
+	// track required properties, if set
+	const auto checkRequired = validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties);
+	QBitArray foundProps{checkRequired ? plan->requiredKeys().size() : 0};
 
 	// now deserialize all json properties
-	const auto cborMap = cValue.toMap();
 	for (auto it = cborMap.constBegin(); it != cborMap.constEnd(); it++) {
-		const auto key = it.key().toString().toUtf8();
-		const auto propIndex = metaObject->indexOfProperty(key);
-		if (propIndex != -1) {
-			const auto property = metaObject->property(propIndex);
-			property.writeOnGadget(gadgetPtr, helper()->deserializeSubtype(property, it.value(), nullptr));
-			reqProps.remove(property.name());
+		const auto key = it.key().toString();
+		if (const auto info = plan->find(key); info) {
+			info->property.writeOnGadget(gadgetPtr, helper()->deserializeSubtype(info->property, info->typeId, it.value(), nullptr));
+			if (checkRequired && info->requiredIndex != -1)
+				foundProps.setBit(info->requiredIndex);
 		} else if (validationFlags.testFlag(SerializerBase::ValidationFlag::NoExtraProperties)) {
 			throw DeserializationException("Found extra property " +
-												key +
+												key.toUtf8() +
 												" but extra properties are not allowed");
 		}
 	}
 
+	if (checkRequired)
+		verifyRequiredProperties(metaObject, plan->requiredKeys(), foundProps);
+}
+
+void GadgetConverter::verifyRequiredProperties(const QMetaObject *metaObject, const QVector<QString> &requiredKeys, const QBitArray &foundProps) const
+{
 	// make sure all required properties have been read
-	if (validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties) && !reqProps.isEmpty()) {
+	if (foundProps.count(true) != foundProps.size()) {
+		QByteArrayList missing;
+		for (auto i = 0; i < foundProps.size(); ++i) {
+			if (!foundProps.testBit(i))
+				missing.append(requiredKeys[i].toUtf8());
+		}
 		throw DeserializationException(QByteArray("Not all properties for ") +
 											metaObject->className() +
 											QByteArray(" are present in the json object. Missing properties: ") +
-											reqProps.toList().join(", "));
+											missing.join(", "));
 	}
-
-	return gadget;
 }
@@ -4,6 +4,9 @@
 #include "qtjsonserializer_global.h"
 #include "typeconverter.h"
 
+#include <QtCore/QBitArray>
+#include <QtCore/QCborMap>
+
 namespace QtJsonSerializer::TypeConverters {
 
 class Q_JSONSERIALIZER_EXPORT GadgetConverter : public TypeConverter
@@ -13,7 +16,23 @@ public:
 	bool canConvert(int metaTypeId) const override;
 	QList<QCborValue::Type> allowedCborTypes(int metaTypeId, QCborTag tag) const override;
 	QCborValue serialize(int propertyType, const QVariant &value) const override;
+	void serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const override;
 	QVariant deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const override;
+	QVariant deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const override;
+	QCborValue serializeData(int propertyType, const void *data) const override;
+	bool deserializeInto(int propertyType, const QCborValue &value, void *data, QObject *parent) const override;
+
+private:
+	// converts value to the gadget type and returns its data, which stays valid as long as value is unchanged
+	const void *gadgetData(int propertyType, QVariant &value) const;
+	// returns nullptr for null gadget pointers
+	const void *gadgetAddress(int propertyType, const void *data) const;
+
+	const QMetaObject *gadgetMetaObject(int propertyType) const;
+	// creates an empty gadget in gadget and returns its address
+	void *createGadget(int propertyType, const QMetaObject *metaObject, QVariant &gadget) const;
+	void deserializeProperties(const QMetaObject *metaObject, const QCborMap &cborMap, void *gadgetPtr) const;
+	void verifyRequiredProperties(const QMetaObject *metaObject, const QVector<QString> &requiredKeys, const QBitArray &foundProps) const;
 };
 
 }
@@ -2,8 +2,13 @@
 #include "exception.h"
 #include "cborserializer.h"
 #include "metawriters.h"
+#include "exceptioncontext_p.h"
+#include "valuereader_p.h"
+
+#include <cstring>
 
 #include <QtCore/QJsonArray>
+#include <QtCore/QtEndian>
 using namespace QtJsonSerializer;
 using namespace QtJsonSerializer::TypeConverters;
 using namespace QtJsonSerializer::MetaWriters;
@@ -16,59 +21,350 @@ bool ListConverter::canConvert(int metaTypeId) const
 
 QList<QCborTag> ListConverter::allowedCborTags(int metaTypeId) const
 {
-	const auto isSet = SequentialWriter::getInfo(metaTypeId).isSet;
+	const auto info = SequentialWriter::getInfo(metaTypeId);
 	QList<QCborTag> tags {
 		NoTag,
 		static_cast<QCborTag>(CborSerializer::Homogeneous)
 	};
-	if (isSet)
+	if (info.isSet)
 		tags.append(static_cast<QCborTag>(CborSerializer::Set));
+	// typed arrays are always accepted, in both byte orders
+	if (const auto typedTag = typedArrayTag(info.type); typedTag != NoTag) {
+		tags.append(typedTag);
+		if (info.type != QMetaType::SChar)
+			tags.append(static_cast<QCborTag>(static_cast<quint64>(typedTag) ^ TypedArrayEndianBit));
+	}
 	return tags;
 }
 
 QList<QCborValue::Type> ListConverter::allowedCborTypes(int metaTypeId, QCborTag tag) const
 {
 	Q_UNUSED(metaTypeId)
-	Q_UNUSED(tag)
-	return {QCborValue::Array};
+	if (isTypedArrayTag(tag))
+		return {QCborValue::ByteArray};
+	else
+		return {QCborValue::Array};
 }
 
 QCborValue ListConverter::serialize(int propertyType, const QVariant &value) const
 {
+	// values of the exact container type are read in place, without wrapping every element
+	if (value.userType() == propertyType) {
+		ScopedReader<SequentialReader> reader;
+		if (SequentialReader::getReader(propertyType, value.constData(), reader))
+			return serializeElements(propertyType, *reader);
+	}
+
 	const auto info = SequentialWriter::getInfo(propertyType);
 
+	QCborArray array;
+	ExceptionContext::Element ctx{0};
+	auto index = 0;
+	for (const auto &element : iterable(propertyType, value)) {
+		ctx.setIndex(index++);
+		array.append(helper()->serializeSubtype(info.type, element));
+	}
+	if (info.isSet)
+		return {static_cast<QCborTag>(CborSerializer::Set), array};
+	else
+		return array;
+}
+
+void ListConverter::serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	if (value.userType() == propertyType) {
+		ScopedReader<SequentialReader> reader;
+		if (SequentialReader::getReader(propertyType, value.constData(), reader)) {
+			serializeElementsTo(propertyType, *reader, writer);
+			return;
+		}
+	}
+
+	const auto info = SequentialWriter::getInfo(propertyType);
+	const auto elements = iterable(propertyType, value);
+
+	if (info.isSet)
+		writer.appendTag(static_cast<QCborTag>(CborSerializer::Set));
+	writer.startArray(elements.size());
+	ExceptionContext::Element ctx{0};
+	auto index = 0;
+	for (const auto &element : elements) {
+		ctx.setIndex(index++);
+		helper()->serializeSubtypeTo(info.type, element, writer);
+	}
+	writer.endArray();
+}
+
+QCborValue ListConverter::serializeData(int propertyType, const void *data) const
+{
+	ScopedReader<SequentialReader> reader;
+	if (SequentialReader::getReader(propertyType, data, reader))
+		return serializeElements(propertyType, *reader);
+	else
+		return serialize(propertyType, QVariant{propertyType, data});
+}
+
+void ListConverter::serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const
+{
+	ScopedReader<SequentialReader> reader;
+	if (SequentialReader::getReader(propertyType, data, reader))
+		serializeElementsTo(propertyType, *reader, writer);
+	else
+		serializeTo(propertyType, QVariant{propertyType, data}, writer);
+}
+
+QVariant ListConverter::deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const
+{
+	if (value.isTag() && isTypedArrayTag(value.tag()))
+		return deserializeTypedArray(propertyType, value.tag(), value.taggedValue().toByteArray());
+
+	//generate the list
+	QVariant list{propertyType, nullptr};
+	ScopedWriter<SequentialWriter> writer;
+	sequentialWriter(propertyType, list, writer);
+
+	const auto info = writer->info();
+	const auto array = (value.isTag() ? value.taggedValue() : value).toArray();
+	ExceptionContext::Element ctx{0};
+	auto index = 0;
+	writer->reserve(static_cast<int>(array.size()));
+	for (auto element : array) {
+		ctx.setIndex(index++);
+		writer->emplace(helper()->deserializeSubtype(info.type, element, parent));
+	}
+	return list;
+}
+
+QVariant ListConverter::deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const
+{
+	// typed arrays are a single byte string, so they are read completely
+	if (const auto tag = reader.tag(); isTypedArrayTag(tag))
+		return deserializeTypedArray(propertyType, tag, reader.read().taggedValue().toByteArray());
+
+	//generate the list
+	QVariant list{propertyType, nullptr};
+	ScopedWriter<SequentialWriter> writer;
+	sequentialWriter(propertyType, list, writer);
+
+	const auto info = writer->info();
+	if (const auto length = reader.length(); length > 0)
+		writer->reserve(reservedLength(length));
+	reader.enterContainer();
+	ExceptionContext::Element ctx{0};
+	auto index = 0;
+	while (reader.hasNext()) {
+		ctx.setIndex(index++);
+		writer->emplace(helper()->deserializeSubtypeFrom(info.type, reader, parent));
+	}
+	reader.leaveContainer();
+	return list;
+}
+
+QSequentialIterable ListConverter::iterable(int propertyType, const QVariant &value) const
+{
 	if (!value.canConvert(QMetaType::QVariantList)) {
 		throw SerializationException(QByteArray("Given type ") +
 										  QMetaType::typeName(propertyType) +
 										  QByteArray(" cannot be processed via QSequentialIterable - make shure to register the container type via Q_DECLARE_SEQUENTIAL_CONTAINER_METATYPE"));
 	}
+	return value.value<QSequentialIterable>();
+}
+
+QCborValue ListConverter::serializeElements(int propertyType, const SequentialReader &reader) const
+{
+	const auto info = reader.info();
+	if (useTypedArray(propertyType, info))
+		return {typedArrayTag(info.type), typedArrayData(reader)};
 
 	QCborArray array;
+	ExceptionContext::Element ctx{0};
 	auto index = 0;
-	for (const auto &element : value.value<QSequentialIterable>())
-		array.append(helper()->serializeSubtype(info.type, element, "[" + QByteArray::number(index++) + "]"));
+	reader.forEach([&](const void *element) {
+		ctx.setIndex(index++);
+		array.append(helper()->serializeSubtypeData(info.type, element));
+	});
 	if (info.isSet)
 		return {static_cast<QCborTag>(CborSerializer::Set), array};
 	else
 		return array;
 }
 
-QVariant ListConverter::deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const
+void ListConverter::serializeElementsTo(int propertyType, const SequentialReader &reader, ValueWriter &writer) const
 {
-	//generate the list
-	QVariant list{propertyType, nullptr};
-	auto writer = SequentialWriter::getWriter(list);
-	if (!writer) {
+	const auto info = reader.info();
+	if (useTypedArray(propertyType, info)) {
+		writer.appendTag(typedArrayTag(info.type));
+		writer.append(typedArrayData(reader));
+		return;
+	}
+
+	if (info.isSet)
+		writer.appendTag(static_cast<QCborTag>(CborSerializer::Set));
+	writer.startArray(reader.size());
+	ExceptionContext::Element ctx{0};
+	auto index = 0;
+	reader.forEach([&](const void *element) {
+		ctx.setIndex(index++);
+		helper()->serializeSubtypeDataTo(info.type, element, writer);
+	});
+	writer.endArray();
+}
+
+void ListConverter::sequentialWriter(int propertyType, QVariant &list, ScopedWriter<SequentialWriter> &writer) const
+{
+	if (!SequentialWriter::getWriter(list, writer)) {
 		throw DeserializationException(QByteArray("Given type ") +
 											QMetaType::typeName(propertyType) +
 											QByteArray(" cannot be accessed via QSequentialWriter - make shure to register it via QJsonSerializerBase::registerListConverters or QJsonSerializerBase::registerSetConverters"));
 	}
+}
+
+QCborTag ListConverter::typedArrayTag(int elementType)
+{
+	// RFC 8746 tags are built as 0b010fsell: float, signed, little endian and the length exponent
+	quint64 format;
+	switch (elementType) {
+	case QMetaType::UChar:
+		return static_cast<QCborTag>(0x40);
+	case QMetaType::SChar:
+		return static_cast<QCborTag>(0x48);
+	case QMetaType::UShort:
+		format = 0x01;
+		break;
+	case QMetaType::Short:
+		format = 0x09;
+		break;
+	case QMetaType::UInt:
+		format = 0x02;
+		break;
+	case QMetaType::Int:
+		format = 0x0A;
+		break;
+	case QMetaType::ULongLong:
+		format = 0x03;
+		break;
+	case QMetaType::LongLong:
+		format = 0x0B;
+		break;
+	case QMetaType::Float:
+		format = 0x11;
+		break;
+	case QMetaType::Double:
+		format = 0x12;
+		break;
+	default:
+		return NoTag;
+	}
+	// elements are always written in host byte order, so they can be copied as they are
+	if (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+		format |= TypedArrayEndianBit;
+	return static_cast<QCborTag>(0x40 | format);
+}
+
+bool ListConverter::isTypedArrayTag(QCborTag tag)
+{
+	return tag >= static_cast<QCborTag>(TypedArrayFirstTag) &&
+		   tag <= static_cast<QCborTag>(TypedArrayLastTag);
+}
+
+void ListConverter::copyTypedArray(const char *source, void *target, int count, int elementSize, bool swapBytes)
+{
+	if (!swapBytes) {
+		memcpy(target, source, static_cast<size_t>(count) * static_cast<size_t>(elementSize));
+		return;
+	}
+
+	// a plain loop over fixed size words, which the compiler can vectorize
+	const auto swapWords = [&](auto word) {
+		using TWord = decltype(word);
+		auto out = static_cast<char*>(target);
+		for (auto i = 0; i < count; ++i)
+			qToUnaligned(qbswap(qFromUnaligned<TWord>(source + i * sizeof(TWord))), out + i * sizeof(TWord));
+	};
+	switch (elementSize) {
+	case 2:
+		swapWords(quint16{});
+		break;
+	case 4:
+		swapWords(quint32{});
+		break;
+	case 8:
+		swapWords(quint64{});
+		break;
+	default:
+		Q_UNREACHABLE();
+		break;
+	}
+}
+
+bool ListConverter::useTypedArray(int propertyType, const SequentialReader::SequenceInfo &info) const
+{
+	// any tag assigned to the list or its elements has to be written, which a typed array cannot do
+	return !helper()->jsonMode() &&
+		   helper()->settings()->typedArrays &&
+		   !info.isSet &&
+		   typedArrayTag(info.type) != NoTag &&
+		   helper()->typeTag(propertyType) == NoTag &&
+		   helper()->typeTag(info.type) == NoTag;
+}
+
+QByteArray ListConverter::typedArrayData(const SequentialReader &reader) const
+{
+	const auto elementSize = QMetaType::sizeOf(reader.info().type);
+	const auto size = static_cast<qint64>(reader.size()) * elementSize;
+	if (size > MaxAllocSize - static_cast<qint64>(sizeof(QByteArrayData)) - 1) {
+		throw SerializationException(QByteArray("Typed array of ") +
+									 QByteArray::number(reader.size()) +
+									 QByteArray(" elements exceeds the maximum size of a QByteArray"));
+	}
+	QByteArray data{static_cast<int>(size), Qt::Uninitialized};
+	// contiguous containers are copied at once, all others element by element
+	if (const auto elements = reader.constData(); elements)
+		memcpy(data.data(), elements, static_cast<size_t>(data.size()));
+	else {
+		auto target = data.data();
+		reader.forEach([&](const void *element) {
+			memcpy(target, element, static_cast<size_t>(elementSize));
+			target += elementSize;
+		});
+	}
+	return data;
+}
+
+QVariant ListConverter::deserializeTypedArray(int propertyType, QCborTag tag, const QByteArray &data) const
+{
+	QVariant list{propertyType, nullptr};
+	ScopedWriter<SequentialWriter> writer;
+	sequentialWriter(propertyType, list, writer);
 
 	const auto info = writer->info();
-	const auto array = (value.isTag() ? value.taggedValue() : value).toArray();
-	auto index = 0;
-	writer->reserve(static_cast<int>(array.size()));
-	for (auto element : array)
-		writer->add(helper()->deserializeSubtype(info.type, element, parent, "[" + QByteArray::number(index++) + "]"));
+	const auto hostTag = typedArrayTag(info.type);
+	// multi byte elements can have either byte order, for uint8 arrays the bit marks them as clamped
+	const auto flippedTag = static_cast<QCborTag>(static_cast<quint64>(tag) ^ TypedArrayEndianBit);
+	if (hostTag == NoTag ||
+		(tag != hostTag && (flippedTag != hostTag || info.type == QMetaType::SChar))) {
+		throw DeserializationException("Typed array tag " + QByteArray::number(static_cast<quint64>(tag)) +
+									   " does not match the element type " + QMetaType::typeName(info.type));
+	}
+	const auto elementSize = QMetaType::sizeOf(info.type);
+	if (data.size() % elementSize != 0) {
+		throw DeserializationException("Typed array of " + QByteArray::number(data.size()) +
+									   " bytes cannot be split into elements of " + QByteArray::number(elementSize) +
+									   " bytes");
+	}
+
+	const auto count = data.size() / elementSize;
+	const auto swapBytes = elementSize > 1 && tag != hostTag;
+	// contiguous containers are filled at once, all others element by element
+	if (const auto elements = writer->resizeData(count); elements)
+		copyTypedArray(data.constData(), elements, count, elementSize, swapBytes);
+	else {
+		writer->reserve(count);
+		quint64 element = 0;
+		for (auto i = 0; i < count; ++i) {
+			copyTypedArray(data.constData() + i * elementSize, &element, 1, elementSize, swapBytes);
+			writer->emplace(QVariant{info.type, &element});
+		}
+	}
 	return list;
 }
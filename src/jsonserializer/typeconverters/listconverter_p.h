@@ -3,6 +3,9 @@
 
 #include "qtjsonserializer_global.h"
 #include "typeconverter.h"
+#include "metawriters.h"
+
+#include <limits>
 
 namespace QtJsonSerializer::TypeConverters {
 
@@ -14,7 +17,32 @@ public:
 	QList<QCborTag> allowedCborTags(int metaTypeId) const override;
 	QList<QCborValue::Type> allowedCborTypes(int metaTypeId, QCborTag tag) const override;
 	QCborValue serialize(int propertyType, const QVariant &value) const override;
+	void serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const override;
+	QCborValue serializeData(int propertyType, const void *data) const override;
+	void serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const override;
 	QVariant deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const override;
+	QVariant deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const override;
+
+	static QCborTag typedArrayTag(int elementType);
+
+private:
+	QSequentialIterable iterable(int propertyType, const QVariant &value) const;
+	// RFC 8746 typed array tags range from the uint8 array to the little endian float128 array
+	static constexpr quint64 TypedArrayFirstTag = 64;
+	static constexpr quint64 TypedArrayLastTag = 87;
+	static constexpr quint64 TypedArrayEndianBit = 0x04;
+	// the largest QByteArray that can be allocated, including its header and terminator
+	static constexpr qint64 MaxAllocSize = std::numeric_limits<int>::max();
+
+	QCborValue serializeElements(int propertyType, const MetaWriters::SequentialReader &reader) const;
+	void serializeElementsTo(int propertyType, const MetaWriters::SequentialReader &reader, ValueWriter &writer) const;
+	void sequentialWriter(int propertyType, QVariant &list, MetaWriters::ScopedWriter<MetaWriters::SequentialWriter> &writer) const;
+
+	static bool isTypedArrayTag(QCborTag tag);
+	static void copyTypedArray(const char *source, void *target, int count, int elementSize, bool swapBytes);
+	bool useTypedArray(int propertyType, const MetaWriters::SequentialReader::SequenceInfo &info) const;
+	QByteArray typedArrayData(const MetaWriters::SequentialReader &reader) const;
+	QVariant deserializeTypedArray(int propertyType, QCborTag tag, const QByteArray &data) const;
 };
 
 }
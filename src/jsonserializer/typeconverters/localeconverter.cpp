@@ -36,7 +36,7 @@ int LocaleConverter::guessType(QCborTag tag, QCborValue::Type dataType) const
 QCborValue LocaleConverter::serialize(int propertyType, const QVariant &value) const
 {
 	Q_UNUSED(propertyType)
-	if (helper()->getProperty("useBcp47Locale").toBool())
+	if (helper()->settings()->useBcp47Locale)
 		return {static_cast<QCborTag>(CborSerializer::LocaleBCP47), value.toLocale().bcp47Name()};
 	else
 		return {static_cast<QCborTag>(CborSerializer::LocaleISO), value.toLocale().name()};
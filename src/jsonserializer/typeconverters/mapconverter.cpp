@@ -2,6 +2,11 @@
 #include "exception.h"
 #include "cborserializer.h"
 #include "metawriters.h"
+#include "exceptioncontext_p.h"
+#include "cbormapbuilder_p.h"
+#include "valuereader_p.h"
+
+#include <vector>
 
 #include <QtCore/QJsonObject>
 using namespace QtJsonSerializer;
@@ -31,45 +36,194 @@ QList<QCborValue::Type> MapConverter::allowedCborTypes(int metaTypeId, QCborTag
 
 QCborValue MapConverter::serialize(int propertyType, const QVariant &value) const
 {
+	// values of the exact container type are read in place, without wrapping every entry
+	if (value.userType() == propertyType) {
+		ScopedReader<AssociativeReader> reader;
+		if (AssociativeReader::getReader(propertyType, value.constData(), reader))
+			return serializeEntries(*reader);
+	}
+
 	const auto info = AssociativeWriter::getInfo(propertyType);
 
-	// verify is readable
-	if (!value.canConvert(QMetaType::QVariantMap) &&
-		!value.canConvert(QMetaType::QVariantHash)) {
-		throw SerializationException(QByteArray("Given type ") +
-										  QMetaType::typeName(propertyType) +
-										  QByteArray(" cannot be processed via QAssociativeIterable - make shure to register the container type via Q_DECLARE_ASSOCIATIVE_CONTAINER_METATYPE"));
+	// write from map to cbor
+	const auto entries = iterable(propertyType, value);
+	CborMapBuilder cborMap{entries.size()};
+	for (auto it = entries.begin(), end = entries.end(); it != end; ++it) {
+		const auto key = it.key();
+		ExceptionContext::Element ctx{key, ".key"};
+		auto cborKey = helper()->serializeSubtype(info.keyType, key);
+		ctx.setSuffix(".value");
+		cborMap.append(cborKey, helper()->serializeSubtype(info.valueType, it.value()));
 	}
+	return cborMap.take();
+}
 
-	// write from map to cbor
-	const auto iterable = value.value<QAssociativeIterable>();
-	QCborMap cborMap;
-	for (auto it = iterable.begin(), end = iterable.end(); it != end; ++it) {
-		const QByteArray keyStr = "[" + it.key().toString().toUtf8() + "]";
-		cborMap.insert(helper()->serializeSubtype(info.keyType, it.key(), keyStr + ".key"),
-					   helper()->serializeSubtype(info.valueType, it.value(), keyStr + ".value"));
+void MapConverter::serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	if (value.userType() == propertyType) {
+		ScopedReader<AssociativeReader> reader;
+		if (AssociativeReader::getReader(propertyType, value.constData(), reader)) {
+			serializeEntriesTo(*reader, writer);
+			return;
+		}
+	}
+
+	const auto info = AssociativeWriter::getInfo(propertyType);
+	const auto entries = iterable(propertyType, value);
+
+	// serialized keys can be equal, so they are collected first to write every key once with its last value
+	std::vector<std::pair<QCborValue, QAssociativeIterable::const_iterator>> cborEntries;
+	cborEntries.reserve(static_cast<std::size_t>(entries.size()));
+	CborKeyIndex keys;
+	keys.reserve(entries.size());
+	for (auto it = entries.begin(), end = entries.end(); it != end; ++it) {
+		const auto key = it.key();
+		ExceptionContext::Element ctx{key, ".key"};
+		auto cborKey = helper()->serializeSubtype(info.keyType, key);
+		const auto position = static_cast<qsizetype>(cborEntries.size());
+		if (const auto index = keys.add(cborKey, position); index != position)
+			cborEntries[static_cast<std::size_t>(index)].second = it;
+		else
+			cborEntries.emplace_back(std::move(cborKey), it);
 	}
-	return cborMap;
+
+	writer.startMap(static_cast<qint64>(cborEntries.size()));
+	for (const auto &[cborKey, it] : cborEntries) {
+		writer.append(cborKey);
+		ExceptionContext::Element ctx{cborKey, ".value"};
+		helper()->serializeSubtypeTo(info.valueType, it.value(), writer);
+	}
+	writer.endMap();
+}
+
+QCborValue MapConverter::serializeData(int propertyType, const void *data) const
+{
+	ScopedReader<AssociativeReader> reader;
+	if (AssociativeReader::getReader(propertyType, data, reader))
+		return serializeEntries(*reader);
+	else
+		return serialize(propertyType, QVariant{propertyType, data});
+}
+
+void MapConverter::serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const
+{
+	ScopedReader<AssociativeReader> reader;
+	if (AssociativeReader::getReader(propertyType, data, reader))
+		serializeEntriesTo(*reader, writer);
+	else
+		serializeTo(propertyType, QVariant{propertyType, data}, writer);
 }
 
 QVariant MapConverter::deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const
 {
 	//generate the map
 	QVariant map{propertyType, nullptr};
-	auto writer = AssociativeWriter::getWriter(map);
-	if (!writer) {
-		throw DeserializationException(QByteArray("Given type ") +
-											QMetaType::typeName(propertyType) +
-											QByteArray(" cannot be accessed via QAssociativeWriter - make shure to register it via QJsonSerializerBase::registerMapConverters"));
-	}
+	ScopedWriter<AssociativeWriter> writer;
+	associativeWriter(propertyType, map, writer);
 
 	// write from cbor into the map
 	const auto info = writer->info();
 	const auto cborMap = (value.isTag() ? value.taggedValue() : value).toMap();
+	writer->reserve(static_cast<int>(cborMap.size()));
 	for (const auto entry : cborMap) {
-		const QByteArray keyStr = "[" + entry.first.toVariant().toString().toUtf8() + "]";
-		writer->add(helper()->deserializeSubtype(info.keyType, entry.first, parent, keyStr + ".key"),
-					helper()->deserializeSubtype(info.valueType, entry.second, parent, keyStr + ".value"));
+		ExceptionContext::Element ctx{entry.first, ".key"};
+		auto key = helper()->deserializeSubtype(info.keyType, entry.first, parent);
+		ctx.setSuffix(".value");
+		writer->emplace(std::move(key), helper()->deserializeSubtype(info.valueType, entry.second, parent));
 	}
 	return map;
 }
+
+QVariant MapConverter::deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const
+{
+	//generate the map
+	QVariant map{propertyType, nullptr};
+	ScopedWriter<AssociativeWriter> writer;
+	associativeWriter(propertyType, map, writer);
+
+	// read the entries from the stream into the map
+	const auto info = writer->info();
+	if (const auto length = reader.length(); length > 0)
+		writer->reserve(reservedLength(length));
+	reader.enterContainer();
+	while (reader.hasNext()) {
+		// keys are small, so they are read completely to be available for the context
+		const auto cborKey = reader.read();
+		ExceptionContext::Element ctx{cborKey, ".key"};
+		auto key = helper()->deserializeSubtype(info.keyType, cborKey, parent);
+		ctx.setSuffix(".value");
+		writer->emplace(std::move(key), helper()->deserializeSubtypeFrom(info.valueType, reader, parent));
+	}
+	reader.leaveContainer();
+	return map;
+}
+
+QAssociativeIterable MapConverter::iterable(int propertyType, const QVariant &value) const
+{
+	// verify is readable
+	if (!value.canConvert(QMetaType::QVariantMap) &&
+		!value.canConvert(QMetaType::QVariantHash)) {
+		throw SerializationException(QByteArray("Given type ") +
+										  QMetaType::typeName(propertyType) +
+										  QByteArray(" cannot be processed via QAssociativeIterable - make shure to register the container type via Q_DECLARE_ASSOCIATIVE_CONTAINER_METATYPE"));
+	}
+	return value.value<QAssociativeIterable>();
+}
+
+QCborValue MapConverter::serializeEntries(const AssociativeReader &reader) const
+{
+	const auto info = reader.info();
+
+	CborMapBuilder cborMap{reader.size()};
+	reader.forEach([&](const void *keyData, const void *valueData) {
+		// keys are wrapped anyway to be available for the context, values are passed by pointer
+		const QVariant key{info.keyType, keyData};
+		ExceptionContext::Element ctx{key, ".key"};
+		auto cborKey = helper()->serializeSubtype(info.keyType, key);
+		ctx.setSuffix(".value");
+		cborMap.append(cborKey, helper()->serializeSubtypeData(info.valueType, valueData));
+	});
+	return cborMap.take();
+}
+
+void MapConverter::serializeEntriesTo(const AssociativeReader &reader, ValueWriter &writer) const
+{
+	const auto info = reader.info();
+
+	// serialized keys can be equal, so they are collected first to write every key once with its last value
+	struct Entry {
+		QCborValue cborKey;
+		const void *valueData;
+	};
+	std::vector<Entry> cborEntries;
+	cborEntries.reserve(static_cast<std::size_t>(reader.size()));
+	CborKeyIndex keys;
+	keys.reserve(reader.size());
+	reader.forEach([&](const void *keyData, const void *valueData) {
+		const QVariant key{info.keyType, keyData};
+		ExceptionContext::Element ctx{key, ".key"};
+		auto cborKey = helper()->serializeSubtype(info.keyType, key);
+		const auto position = static_cast<qsizetype>(cborEntries.size());
+		if (const auto index = keys.add(cborKey, position); index != position)
+			cborEntries[static_cast<std::size_t>(index)].valueData = valueData;
+		else
+			cborEntries.push_back({std::move(cborKey), valueData});
+	});
+
+	writer.startMap(static_cast<qint64>(cborEntries.size()));
+	for (const auto &entry : cborEntries) {
+		writer.append(entry.cborKey);
+		ExceptionContext::Element ctx{entry.cborKey, ".value"};
+		helper()->serializeSubtypeDataTo(info.valueType, entry.valueData, writer);
+	}
+	writer.endMap();
+}
+
+void MapConverter::associativeWriter(int propertyType, QVariant &map, ScopedWriter<AssociativeWriter> &writer) const
+{
+	if (!AssociativeWriter::getWriter(map, writer)) {
+		throw DeserializationException(QByteArray("Given type ") +
+											QMetaType::typeName(propertyType) +
+											QByteArray(" cannot be accessed via QAssociativeWriter - make shure to register it via QJsonSerializerBase::registerMapConverters"));
+	}
+}
@@ -3,6 +3,7 @@
 
 #include "qtjsonserializer_global.h"
 #include "typeconverter.h"
+#include "metawriters.h"
 
 namespace QtJsonSerializer::TypeConverters {
 
@@ -14,7 +15,17 @@ public:
 	QList<QCborTag> allowedCborTags(int metaTypeId) const override;
 	QList<QCborValue::Type> allowedCborTypes(int metaTypeId, QCborTag tag) const override;
 	QCborValue serialize(int propertyType, const QVariant &value) const override;
+	void serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const override;
+	QCborValue serializeData(int propertyType, const void *data) const override;
+	void serializeDataTo(int propertyType, const void *data, ValueWriter &writer) const override;
 	QVariant deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const override;
+	QVariant deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const override;
+
+private:
+	QAssociativeIterable iterable(int propertyType, const QVariant &value) const;
+	QCborValue serializeEntries(const MetaWriters::AssociativeReader &reader) const;
+	void serializeEntriesTo(const MetaWriters::AssociativeReader &reader, ValueWriter &writer) const;
+	void associativeWriter(int propertyType, QVariant &map, MetaWriters::ScopedWriter<MetaWriters::AssociativeWriter> &writer) const;
 };
 
 }
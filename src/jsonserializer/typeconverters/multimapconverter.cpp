@@ -1,6 +1,10 @@
 #include "multimapconverter_p.h"
 #include "exception.h"
 #include "cborserializer.h"
+#include "exceptioncontext_p.h"
+#include "cbormapbuilder_p.h"
+
+#include <vector>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
@@ -37,56 +41,47 @@ QCborValue MultiMapConverter::serialize(int propertyType, const QVariant &value)
 {
 	const auto info = AssociativeWriter::getInfo(propertyType);
 
-	// verify is readable
-	if (!value.canConvert(QMetaType::QVariantMap) &&
-		!value.canConvert(QMetaType::QVariantHash)) {
-		throw SerializationException(QByteArray("Given type ") +
-										  QMetaType::typeName(propertyType) +
-										  QByteArray(" cannot be processed via QAssociativeIterable - make shure to register the container type via Q_DECLARE_ASSOCIATIVE_CONTAINER_METATYPE"));
-	}
-
 	// write from map to cbor
-	const auto mapMode = helper()->getProperty("multiMapMode").value<SerializerBase::MultiMapMode>();
-	const auto iterable = value.value<QAssociativeIterable>();
+	const auto mapMode = helper()->settings()->multiMapMode;
+	const auto entries = iterable(propertyType, value);
 	switch (mapMode) {
 	case SerializerBase::MultiMapMode::Map:
 	case SerializerBase::MultiMapMode::DenseMap: {
-		QCborMap cborMap;
-		for (auto it = iterable.begin(), end = iterable.end(); it != end; ++it) {
-			const QByteArray keyStr = "[" + it.key().toString().toUtf8() + "]";
-			const auto key = helper()->serializeSubtype(info.keyType, it.key(), keyStr + ".key");
-			auto mValueRef = cborMap[key];
-			const auto vType = mapMode == SerializerBase::MultiMapMode::DenseMap ?
-				mValueRef.type() :
-				QCborValue::Array;
-			switch (vType) {
-			case QCborValue::Array: {
-				auto mArray = mValueRef.toArray();
-				mValueRef = QCborValue{}; // "clear" the array spot, reducing the ref cnt on mArray to 1, so stuff is added without copying
-				mArray.append(helper()->serializeSubtype(info.valueType, it.value(), keyStr + ".value"));
-				mValueRef = mArray;
-				break;
-			}
-			case QCborValue::Undefined:
-				mValueRef = helper()->serializeSubtype(info.valueType, it.value(), keyStr + ".value");
-				break;
-			default: {
-				QCborArray mArray {mValueRef};
-				mArray.append(helper()->serializeSubtype(info.valueType, it.value(), keyStr + ".value"));
-				mValueRef = mArray;
-				break;
-			}
-			}
+		// the values of equal keys are combined, even if the keys only became equal by serializing them
+		std::vector<std::pair<QCborValue, QCborArray>> groups;
+		CborKeyIndex keys;
+		for (auto it = entries.begin(), end = entries.end(); it != end; ++it) {
+			const auto vKey = it.key();
+			ExceptionContext::Element ctx{vKey, ".key"};
+			auto key = helper()->serializeSubtype(info.keyType, vKey);
+			ctx.setSuffix(".value");
+			auto cborValue = helper()->serializeSubtype(info.valueType, it.value());
+			const auto position = static_cast<qsizetype>(groups.size());
+			if (const auto index = keys.add(key, position); index != position)
+				groups[static_cast<std::size_t>(index)].second.append(std::move(cborValue));
+			else
+				groups.emplace_back(std::move(key), QCborArray{std::move(cborValue)});
 		}
-		return {static_cast<QCborTag>(CborSerializer::MultiMap), cborMap};
+
+		CborMapBuilder cborMap{static_cast<qsizetype>(groups.size())};
+		for (const auto &[key, values] : groups) {
+			if (mapMode == SerializerBase::MultiMapMode::DenseMap && values.size() == 1)
+				cborMap.append(key, values.first());
+			else
+				cborMap.append(key, values);
+		}
+		return {static_cast<QCborTag>(CborSerializer::MultiMap), cborMap.take()};
 	}
 	case SerializerBase::MultiMapMode::List: {
 		QCborArray cborArray;
-		for (auto it = iterable.begin(), end = iterable.end(); it != end; ++it) {
-			const QByteArray keyStr = "[" + it.key().toString().toUtf8() + "]";
+		for (auto it = entries.begin(), end = entries.end(); it != end; ++it) {
+			const auto vKey = it.key();
+			ExceptionContext::Element ctx{vKey, ".key"};
+			auto key = helper()->serializeSubtype(info.keyType, vKey);
+			ctx.setSuffix(".value");
 			cborArray.append(QCborArray{
-				helper()->serializeSubtype(info.keyType, it.key(), keyStr + ".key"),
-				helper()->serializeSubtype(info.valueType, it.value(), keyStr + ".value")
+				std::move(key),
+				helper()->serializeSubtype(info.valueType, it.value())
 			});
 		}
 		return {static_cast<QCborTag>(CborSerializer::MultiMap), cborArray};
@@ -97,12 +92,72 @@ QCborValue MultiMapConverter::serialize(int propertyType, const QVariant &value)
 	}
 }
 
+void MultiMapConverter::serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	const auto info = AssociativeWriter::getInfo(propertyType);
+
+	// write from map to the writer
+	const auto mapMode = helper()->settings()->multiMapMode;
+	const auto entries = iterable(propertyType, value);
+	writer.appendTag(static_cast<QCborTag>(CborSerializer::MultiMap));
+	switch (mapMode) {
+	case SerializerBase::MultiMapMode::Map:
+	case SerializerBase::MultiMapMode::DenseMap: {
+		// the keys are grouped first, so the size of the map and of every value array is known
+		std::vector<std::pair<QCborValue, std::vector<QAssociativeIterable::const_iterator>>> groups;
+		CborKeyIndex keys;
+		for (auto it = entries.begin(), end = entries.end(); it != end; ++it) {
+			const auto vKey = it.key();
+			ExceptionContext::Element ctx{vKey, ".key"};
+			auto key = helper()->serializeSubtype(info.keyType, vKey);
+			const auto position = static_cast<qsizetype>(groups.size());
+			if (const auto index = keys.add(key, position); index != position)
+				groups[static_cast<std::size_t>(index)].second.push_back(it);
+			else
+				groups.emplace_back(std::move(key), std::vector<QAssociativeIterable::const_iterator>{it});
+		}
+
+		writer.startMap(static_cast<qint64>(groups.size()));
+		for (const auto &[key, values] : groups) {
+			writer.append(key);
+			const auto dense = mapMode == SerializerBase::MultiMapMode::DenseMap && values.size() == 1;
+			if (!dense)
+				writer.startArray(static_cast<qint64>(values.size()));
+			ExceptionContext::Element ctx{key, ".value"};
+			for (const auto &it : values)
+				helper()->serializeSubtypeTo(info.valueType, it.value(), writer);
+			if (!dense)
+				writer.endArray();
+		}
+		writer.endMap();
+		break;
+	}
+	case SerializerBase::MultiMapMode::List: {
+		writer.startArray(entries.size());
+		for (auto it = entries.begin(), end = entries.end(); it != end; ++it) {
+			const auto vKey = it.key();
+			ExceptionContext::Element ctx{vKey, ".key"};
+			writer.startArray(2);
+			helper()->serializeSubtypeTo(info.keyType, vKey, writer);
+			ctx.setSuffix(".value");
+			helper()->serializeSubtypeTo(info.valueType, it.value(), writer);
+			writer.endArray();
+		}
+		writer.endArray();
+		break;
+	}
+	default:
+		Q_UNREACHABLE();
+		break;
+	}
+}
+
 QVariant MultiMapConverter::deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const
 {
 	// generate the map
 	QVariant map{propertyType, nullptr};
-	auto writer = AssociativeWriter::getWriter(map);
-	if (!writer) {
+	ScopedWriter<AssociativeWriter> writer;
+	if (!AssociativeWriter::getWriter(map, writer)) {
 		throw DeserializationException(QByteArray("Given type ") +
 											QMetaType::typeName(propertyType) +
 											QByteArray(" cannot be accessed via QAssociativeWriter - make shure to register it via QJsonSerializerBase::registerMapConverters"));
@@ -114,25 +169,33 @@ QVariant MultiMapConverter::deserializeCbor(int propertyType, const QCborValue &
 	switch (cValue.type()) {
 	case QCborValue::Map: {
 		for (const auto entry : cValue.toMap()) {
-			const QByteArray keyStr = "[" + entry.first.toVariant().toString().toUtf8() + "]";
-			const auto key = helper()->deserializeSubtype(info.keyType, entry.first, parent, keyStr + ".key");
+			ExceptionContext::Element ctx{entry.first, ".key"};
+			const auto key = helper()->deserializeSubtype(info.keyType, entry.first, parent);
 			if (entry.second.isArray()) {
 				auto cnt = 0;
-				for (const auto aValue : entry.second.toArray())
-					writer->add(key, helper()->deserializeSubtype(info.valueType, aValue, parent, keyStr + ".value[" + QByteArray::number(cnt++) + "]"));
-			} else
-				writer->add(key, helper()->deserializeSubtype(info.valueType, entry.second, parent, keyStr + ".value"));
+				for (const auto aValue : entry.second.toArray()) {
+					ctx.setSuffix(".value", cnt++);
+					writer->add(key, helper()->deserializeSubtype(info.valueType, aValue, parent));
+				}
+			} else {
+				ctx.setSuffix(".value");
+				writer->add(key, helper()->deserializeSubtype(info.valueType, entry.second, parent));
+			}
 		}
 		break;
 	}
 	case QCborValue::Array: {
-		for (const auto aValue : cValue.toArray()) {
+		const auto cArray = cValue.toArray();
+		writer->reserve(static_cast<int>(cArray.size()));
+		for (const auto aValue : cArray) {
 			const auto vPair = aValue.toArray();
 			if (vPair.size() != 2)
 				throw DeserializationException("CBOR/JSON array must have exactly 2 elements to be read as a value of a multi map");
-			const QByteArray keyStr = "[" + vPair[0].toVariant().toString().toUtf8() + "]";
-			writer->add(helper()->deserializeSubtype(info.keyType, vPair[0], parent, keyStr + ".key"),
-						helper()->deserializeSubtype(info.valueType, vPair[1], parent, keyStr + ".value"));
+			const auto cKey = vPair[0];
+			ExceptionContext::Element ctx{cKey, ".key"};
+			auto key = helper()->deserializeSubtype(info.keyType, cKey, parent);
+			ctx.setSuffix(".value");
+			writer->emplace(std::move(key), helper()->deserializeSubtype(info.valueType, vPair[1], parent));
 		}
 		break;
 	}
@@ -142,3 +205,15 @@ QVariant MultiMapConverter::deserializeCbor(int propertyType, const QCborValue &
 
 	return map;
 }
+
+QAssociativeIterable MultiMapConverter::iterable(int propertyType, const QVariant &value) const
+{
+	// verify is readable
+	if (!value.canConvert(QMetaType::QVariantMap) &&
+		!value.canConvert(QMetaType::QVariantHash)) {
+		throw SerializationException(QByteArray("Given type ") +
+										  QMetaType::typeName(propertyType) +
+										  QByteArray(" cannot be processed via QAssociativeIterable - make shure to register the container type via Q_DECLARE_ASSOCIATIVE_CONTAINER_METATYPE"));
+	}
+	return value.value<QAssociativeIterable>();
+}
@@ -14,7 +14,11 @@ public:
 	QList<QCborTag> allowedCborTags(int metaTypeId) const override;
 	QList<QCborValue::Type> allowedCborTypes(int metaTypeId, QCborTag tag) const override;
 	QCborValue serialize(int propertyType, const QVariant &value) const override;
+	void serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const override;
 	QVariant deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const override;
+
+private:
+	QAssociativeIterable iterable(int propertyType, const QVariant &value) const;
 };
 
 }
@@ -1,8 +1,12 @@
 #include "objectconverter_p.h"
 #include "exception.h"
 #include "cborserializer.h"
+#include "propertyplan_p.h"
+#include "cbormapbuilder_p.h"
 
 #include <array>
+
+#include <QtCore/QBitArray>
 using namespace QtJsonSerializer;
 using namespace QtJsonSerializer::TypeConverters;
 
@@ -54,49 +58,51 @@ QCborValue ObjectConverter::serialize(int propertyType, const QVariant &value) c
 	auto object = value.value<QObject*>();
 	if (!object)
 		return QCborValue::Null;
-	QCborMap cborMap;
 
-	// get the metaobject, based on polymorphism
-	const QMetaObject *metaObject = nullptr;
-	auto poly = static_cast<SerializerBase::Polymorphing>(helper()->getProperty("polymorphing").toInt());
 	auto isPoly = false;
-	switch (poly) {
-	case SerializerBase::Polymorphing::Disabled:
-		isPoly = false;
-		break;
-	case SerializerBase::Polymorphing::Enabled:
-		isPoly = polyMetaObject(object);
-		break;
-	case SerializerBase::Polymorphing::Forced:
-		isPoly = true;
-		break;
-	default:
-		Q_UNREACHABLE();
-		break;
-	}
-
-	if (isPoly) {
-		metaObject = object->metaObject();
-		//first: pass the class name
-		cborMap[QStringLiteral("@class")] = QString::fromUtf8(metaObject->className());
-	} else
-		metaObject = QMetaType::metaObjectForType(propertyType);
-	if (!metaObject)
-		throw SerializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
+	const auto metaObject = serializedMetaObject(propertyType, object, isPoly);
+	CborMapBuilder cborMap;
+	//first: pass the class name
+	if (isPoly)
+		cborMap.append(QStringLiteral("@class"), QString::fromUtf8(metaObject->className()));
 
 	//go through all properties and try to serialize them
-	const auto keepObjectName = helper()->getProperty("keepObjectName").toBool();
-	const auto ignoreStoredAttribute = helper()->getProperty("ignoreStoredAttribute").toBool();
-	auto i = QObject::staticMetaObject.indexOfProperty("objectName");
-	if (!keepObjectName)
-		i++;
-	for(; i < metaObject->propertyCount(); i++) {
-		auto property = metaObject->property(i);
-		if (ignoreStoredAttribute || property.isStored())
-			cborMap[QString::fromUtf8(property.name())] = helper()->serializeSubtype(property, property.read(object));
+	const auto settings = helper()->settings();
+	const auto plan = PropertyPlan::get(metaObject,
+										firstPropertyIndex(settings->keepObjectName),
+										settings->ignoreStoredAttribute);
+	for (const auto &info : plan->properties())
+		cborMap.append(info.key, helper()->serializeSubtype(info.property, info.typeId, info.property.read(object)));
+
+	return cborMap.take();
+}
+
+void ObjectConverter::serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const
+{
+	auto object = value.value<QObject*>();
+	if (!object) {
+		writer.append(QCborValue::Null);
+		return;
 	}
 
-	return cborMap;
+	auto isPoly = false;
+	const auto metaObject = serializedMetaObject(propertyType, object, isPoly);
+	const auto settings = helper()->settings();
+	const auto plan = PropertyPlan::get(metaObject,
+										firstPropertyIndex(settings->keepObjectName),
+										settings->ignoreStoredAttribute);
+	const auto &properties = plan->properties();
+
+	writer.startMap(properties.size() + (isPoly ? 1 : 0));
+	if (isPoly) {
+		writer.append(QStringLiteral("@class"));
+		writer.append(QString::fromUtf8(metaObject->className()));
+	}
+	for (const auto &info : properties) {
+		writer.append(info.key);
+		helper()->serializeSubtypeTo(info.property, info.typeId, info.property.read(object), writer);
+	}
+	writer.endMap();
 }
 
 QVariant ObjectConverter::deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const
@@ -115,7 +121,7 @@ QVariant ObjectConverter::deserializeCbor(int propertyType, const QCborValue &va
 	} else
 		cborMap = value.toMap();
 
-	auto poly = static_cast<SerializerBase::Polymorphing>(helper()->getProperty("polymorphing").toInt());
+	auto poly = helper()->settings()->polymorphing;
 
 	auto metaObject = QMetaType::metaObjectForType(propertyType);
 	if (!metaObject)
@@ -126,34 +132,130 @@ QVariant ObjectConverter::deserializeCbor(int propertyType, const QCborValue &va
 	if (poly != SerializerBase::Polymorphing::Disabled) {
 		if (cborMap.contains(QStringLiteral("@class"))) {
 			isPoly = true;
-			QByteArray classField = cborMap[QStringLiteral("@class")].toString().toUtf8() + "*";  // add the star
-			auto typeId = QMetaType::type(classField.constData());
-			auto nMeta = QMetaType::metaObjectForType(typeId);
-			if (!nMeta)
-				throw DeserializationException("Unable to find class requested from json \"@class\" property: " + classField);
-			if (!nMeta->inherits(metaObject)) {
-				throw DeserializationException("Requested class from \"@class\" field, " +
-													classField +
-													QByteArray(", does not inhert the property type ") +
-													QMetaType::typeName(propertyType));
+			metaObject = classMetaObject(propertyType, metaObject, cborMap[QStringLiteral("@class")]);
+		} else if (poly == SerializerBase::Polymorphing::Forced)
+			throw DeserializationException("Json does not contain the \"@class\" field, but forced polymorphism requires it");
+	}
+
+	auto object = constructObject(metaObject, parent);
+	deserializeProperties(metaObject, object, cborMap, isPoly);
+	return QVariant::fromValue(object);
+}
+
+QVariant ObjectConverter::deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const
+{
+	// generic and constructed objects are rare, and thus read as a whole
+	if (reader.type() != QCborValue::Map)
+		return TypeConverter::deserializeFrom(propertyType, reader, parent);
+
+	auto metaObject = QMetaType::metaObjectForType(propertyType);
+	if (!metaObject)
+		throw DeserializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
+
+	const auto tag = reader.tag();
+	reader.enterContainer();
+
+	// try to get the polymorphic metatype (if allowed)
+	auto isPoly = false;
+	if (const auto poly = helper()->settings()->polymorphing; poly != SerializerBase::Polymorphing::Disabled) {
+		if (reader.hasNext()) {
+			const auto firstKey = reader.read();
+			if (firstKey == QStringLiteral("@class")) {
+				isPoly = true;
+				metaObject = classMetaObject(propertyType, metaObject, reader.read());
+			} else {
+				// the object can only be constructed before its properties are read if "@class" comes first
+				CborMapBuilder cborMap;
+				cborMap.append(firstKey, reader.read());
+				while (reader.hasNext()) {
+					const auto key = reader.read();
+					cborMap.append(key, reader.read());
+				}
+				reader.leaveContainer();
+				if (tag != NoTag)
+					return deserializeCbor(propertyType, {tag, cborMap.take()}, parent);
+				else
+					return deserializeCbor(propertyType, cborMap.take(), parent);
 			}
-			metaObject = nMeta;
 		} else if (poly == SerializerBase::Polymorphing::Forced)
 			throw DeserializationException("Json does not contain the \"@class\" field, but forced polymorphism requires it");
 	}
 
-	// try to construct the object
-	auto object = metaObject->newInstance(Q_ARG(QObject*, parent));
-	if (!object) {
-		throw DeserializationException(QByteArray("Failed to construct object of type ") +
-											metaObject->className() +
-											QByteArray(" (Does the constructor \"Q_INVOKABLE class(QObject*);\" exist?)"));
+	auto object = constructObject(metaObject, parent);
+
+	const auto settings = helper()->settings();
+	const auto validationFlags = settings->validationFlags;
+	const auto plan = PropertyPlan::get(metaObject,
+										firstPropertyIndex(settings->keepObjectName),
+										settings->ignoreStoredAttribute);
+
+	// track required properties, if set
+	const auto checkRequired = validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties);
+	QBitArray foundProps{checkRequired ? plan->requiredKeys().size() : 0};
+
+	// now deserialize all properties, directly from the stream
+	while (reader.hasNext()) {
+		const auto cborKey = reader.read();
+		if (isPoly && cborKey == QStringLiteral("@class")) {
+			reader.read();
+			continue;
+		}
+
+		const auto key = cborKey.toString();
+		if (const auto info = plan->find(key); info) {
+			info->property.write(object, helper()->deserializeSubtypeFrom(info->property, info->typeId, reader, object));
+			if (checkRequired && info->requiredIndex != -1)
+				foundProps.setBit(info->requiredIndex);
+		} else if (validationFlags.testFlag(SerializerBase::ValidationFlag::NoExtraProperties)) {
+			throw DeserializationException("Found extra property " +
+												key.toUtf8() +
+												" but extra properties are not allowed");
+		} else {
+			const auto name = key.toUtf8();
+			object->setProperty(name, helper()->deserializeSubtypeFrom(QMetaType::UnknownType, reader, object, name));
+		}
 	}
+	reader.leaveContainer();
 
-	deserializeProperties(metaObject, object, cborMap, isPoly);
+	if (checkRequired)
+		verifyRequiredProperties(metaObject, plan->requiredKeys(), foundProps);
 	return QVariant::fromValue(object);
 }
 
+int ObjectConverter::firstPropertyIndex(bool keepObjectName)
+{
+	static const auto objectNameIndex = QObject::staticMetaObject.indexOfProperty("objectName");
+	return keepObjectName ? objectNameIndex : objectNameIndex + 1;
+}
+
+const QMetaObject *ObjectConverter::serializedMetaObject(int propertyType, QObject *object, bool &isPoly) const
+{
+	// get the metaobject, based on polymorphism
+	const QMetaObject *metaObject = nullptr;
+	switch (helper()->settings()->polymorphing) {
+	case SerializerBase::Polymorphing::Disabled:
+		isPoly = false;
+		break;
+	case SerializerBase::Polymorphing::Enabled:
+		isPoly = polyMetaObject(object);
+		break;
+	case SerializerBase::Polymorphing::Forced:
+		isPoly = true;
+		break;
+	default:
+		Q_UNREACHABLE();
+		break;
+	}
+
+	if (isPoly)
+		metaObject = object->metaObject();
+	else
+		metaObject = QMetaType::metaObjectForType(propertyType);
+	if (!metaObject)
+		throw SerializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
+	return metaObject;
+}
+
 bool ObjectConverter::polyMetaObject(QObject *object) const
 {
 	auto meta = object->metaObject();
@@ -269,47 +371,80 @@ QObject *ObjectConverter::deserializeConstructedObject(const QCborValue &value,
 
 void ObjectConverter::deserializeProperties(const QMetaObject *metaObject, QObject *object, const QCborMap &value, bool isPoly) const
 {
-	auto validationFlags = helper()->getProperty("validationFlags").value<SerializerBase::ValidationFlags>();
-	auto keepObjectName = helper()->getProperty("keepObjectName").toBool();
-
-	// collect required properties, if set
-	QSet<QByteArray> reqProps;
-	if (validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties)) {
-		const auto ignoreStoredAttribute = helper()->getProperty("ignoreStoredAttribute").toBool();
-		auto i = QObject::staticMetaObject.indexOfProperty("objectName");
-		if (!keepObjectName)
-			i++;
-		for (; i < metaObject->propertyCount(); i++) {
-			auto property = metaObject->property(i);
-			if(ignoreStoredAttribute || property.isStored())
-				reqProps.insert(property.name());
-		}
-	}
+	const auto settings = helper()->settings();
+	const auto validationFlags = settings->validationFlags;
+	const auto plan = PropertyPlan::get(metaObject,
+										firstPropertyIndex(settings->keepObjectName),
+										settings->ignoreStoredAttribute);
+
+	// track required properties, if set
+	const auto checkRequired = validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties);
+	QBitArray foundProps{checkRequired ? plan->requiredKeys().size() : 0};
 
 	//now deserialize all json properties
 	for (auto it = value.constBegin(); it != value.constEnd(); it++) {
 		if (isPoly && it.key() == QStringLiteral("@class"))
 			continue;
 
-		const auto key = it.key().toString().toUtf8();
-		const auto propIndex = metaObject->indexOfProperty(key);
-		if (propIndex != -1) {
-			const auto property = metaObject->property(propIndex);
-			property.write(object, helper()->deserializeSubtype(property, it.value(), object));
-			reqProps.remove(property.name());
+		const auto key = it.key().toString();
+		if (const auto info = plan->find(key); info) {
+			info->property.write(object, helper()->deserializeSubtype(info->property, info->typeId, it.value(), object));
+			if (checkRequired && info->requiredIndex != -1)
+				foundProps.setBit(info->requiredIndex);
 		} else if (validationFlags.testFlag(SerializerBase::ValidationFlag::NoExtraProperties)) {
 			throw DeserializationException("Found extra property " +
-												key +
+												key.toUtf8() +
 												" but extra properties are not allowed");
-		} else
-			object->setProperty(key, helper()->deserializeSubtype(QMetaType::UnknownType, it.value(), object, key));
+		} else {
+			const auto name = key.toUtf8();
+			object->setProperty(name, helper()->deserializeSubtype(QMetaType::UnknownType, it.value(), object, name));
+		}
 	}
 
+	if (checkRequired)
+		verifyRequiredProperties(metaObject, plan->requiredKeys(), foundProps);
+}
+
+const QMetaObject *ObjectConverter::classMetaObject(int propertyType, const QMetaObject *metaObject, const QCborValue &classValue) const
+{
+	QByteArray classField = classValue.toString().toUtf8() + "*";  // add the star
+	auto typeId = QMetaType::type(classField.constData());
+	auto nMeta = QMetaType::metaObjectForType(typeId);
+	if (!nMeta)
+		throw DeserializationException("Unable to find class requested from json \"@class\" property: " + classField);
+	if (!nMeta->inherits(metaObject)) {
+		throw DeserializationException("Requested class from \"@class\" field, " +
+											classField +
+											QByteArray(", does not inhert the property type ") +
+											QMetaType::typeName(propertyType));
+	}
+	return nMeta;
+}
+
+QObject *ObjectConverter::constructObject(const QMetaObject *metaObject, QObject *parent) const
+{
+	// try to construct the object
+	auto object = metaObject->newInstance(Q_ARG(QObject*, parent));
+	if (!object) {
+		throw DeserializationException(QByteArray("Failed to construct object of type ") +
+											metaObject->className() +
+											QByteArray(" (Does the constructor \"Q_INVOKABLE class(QObject*);\" exist?)"));
+	}
+	return object;
+}
+
+void ObjectConverter::verifyRequiredProperties(const QMetaObject *metaObject, const QVector<QString> &requiredKeys, const QBitArray &foundProps) const
+{
 	//make shure all required properties have been read
-	if (validationFlags.testFlag(SerializerBase::ValidationFlag::AllProperties) && !reqProps.isEmpty()) {
+	if (foundProps.count(true) != foundProps.size()) {
+		QByteArrayList missing;
+		for (auto i = 0; i < foundProps.size(); ++i) {
+			if (!foundProps.testBit(i))
+				missing.append(requiredKeys[i].toUtf8());
+		}
 		throw DeserializationException(QByteArray("Not all properties for ") +
 											metaObject->className() +
 											QByteArray(" are present in the json object Missing properties: ") +
-											reqProps.toList().join(", "));
+											missing.join(", "));
 	}
 }
@@ -5,6 +5,7 @@
 #include "typeconverter.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QBitArray>
 
 namespace QtJsonSerializer::TypeConverters {
 
@@ -17,14 +18,23 @@ public:
 	QList<QCborValue::Type> allowedCborTypes(int metaTypeId, QCborTag tag) const override;
 	int guessType(QCborTag tag, QCborValue::Type dataType) const override;
 	QCborValue serialize(int propertyType, const QVariant &value) const override;
+	void serializeTo(int propertyType, const QVariant &value, ValueWriter &writer) const override;
 	QVariant deserializeCbor(int propertyType, const QCborValue &value, QObject *parent) const override;
+	QVariant deserializeFrom(int propertyType, ValueReader &reader, QObject *parent) const override;
 
 private:
+	static int firstPropertyIndex(bool keepObjectName);
+
+	const QMetaObject *serializedMetaObject(int propertyType, QObject *object, bool &isPoly) const;
 	bool polyMetaObject(QObject *object) const;
 
 	QObject *deserializeGenericObject(const QCborArray &value, QObject *parent) const;
 	QObject *deserializeConstructedObject(const QCborValue &value, QObject *parent) const;
 	void deserializeProperties(const QMetaObject *metaObject, QObject *object, const QCborMap &value, bool isPoly = false) const;
+
+	const QMetaObject *classMetaObject(int propertyType, const QMetaObject *metaObject, const QCborValue &classValue) const;
+	QObject *constructObject(const QMetaObject *metaObject, QObject *parent) const;
+	void verifyRequiredProperties(const QMetaObject *metaObject, const QVector<QString> &requiredKeys, const QBitArray &foundProps) const;
 };
 
 Q_DECLARE_LOGGING_CATEGORY(logObjConverter)
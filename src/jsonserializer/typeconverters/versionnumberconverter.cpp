@@ -39,7 +39,7 @@ QCborValue VersionNumberConverter::serialize(int propertyType, const QVariant &v
 {
 	Q_UNUSED(propertyType)
 	const auto version = value.value<QVersionNumber>();
-	if (helper()->getProperty("versionAsString").toBool())
+	if (helper()->settings()->versionAsString)
 		return {static_cast<QCborTag>(CborSerializer::VersionNumber), version.toString()};
 	else {
 		QCborArray array;
@@ -0,0 +1,685 @@
+#include "valuereader.h"
+#include "valuereader_p.h"
+#include "exception.h"
+#include "cbormapbuilder_p.h"
+using namespace QtJsonSerializer;
+
+ValueReader::ValueReader() = default;
+
+ValueReader::~ValueReader() = default;
+
+void ValueReader::skip()
+{
+	read();
+}
+
+// ------------- private implementation -------------
+
+CborValueReader::CborValueReader(QCborStreamReader *reader) :
+	_reader{reader}
+{}
+
+QCborTag CborValueReader::tag() const
+{
+	prepare();
+	return _tag;
+}
+
+QCborValue::Type CborValueReader::type() const
+{
+	prepare();
+	return _type;
+}
+
+qint64 CborValueReader::length() const
+{
+	prepare();
+	if (!_value && !_bytes && _reader->isLengthKnown())
+		return static_cast<qint64>(_reader->length());
+	else
+		return -1;
+}
+
+bool CborValueReader::hasNext() const
+{
+	return _prepared || _reader->hasNext();
+}
+
+QCborValue CborValueReader::read()
+{
+	prepare();
+	_prepared = false;
+	if (_value) {
+		const auto value = *_value;
+		_value.reset();
+		return value;
+	} else if (_bytes) {
+		// the caller gets an independent value, so the bytes are copied after all
+		const QCborValue value{*_bytes};
+		_bytes.reset();
+		return value;
+	}
+
+	const auto value = QCborValue::fromCbor(*_reader);
+	checkError();
+	if (_tag != TypeConverter::NoTag)
+		return {_tag, value};
+	else
+		return value;
+}
+
+void CborValueReader::skip()
+{
+	if (_prepared) {
+		_prepared = false;
+		if (_value || _bytes) {
+			_value.reset();
+			_bytes.reset();
+			return;
+		}
+	} else {
+		// tags are separate items in the stream, so they are skipped together with the value they belong to
+		while (_reader->isTag()) {
+			_reader->next();
+			checkError();
+		}
+	}
+	_reader->next();
+	checkError();
+}
+
+void CborValueReader::enterContainer()
+{
+	prepare();
+	Q_ASSERT_X(!_value && !_bytes, Q_FUNC_INFO, "Only arrays and maps can be entered");
+	_prepared = false;
+	_reader->enterContainer();
+	checkError();
+}
+
+void CborValueReader::leaveContainer()
+{
+	_prepared = false;
+	_value.reset();
+	_bytes.reset();
+	while (_reader->hasNext()) {
+		_reader->next();
+		checkError();
+	}
+	_reader->leaveContainer();
+	checkError();
+}
+
+void CborValueReader::setRawData(const QByteArray &rawData)
+{
+	_rawData = rawData;
+}
+
+std::optional<QByteArray> CborValueReader::takeRawByteArray()
+{
+	prepare();
+	if (!_bytes)
+		return std::nullopt;
+
+	_prepared = false;
+	_rawDataReferenced = true;
+	auto bytes = std::move(_bytes);
+	_bytes.reset();
+	return bytes;
+}
+
+bool CborValueReader::isRawDataReferenced() const
+{
+	return _rawDataReferenced;
+}
+
+void CborValueReader::prepare() const
+{
+	if (_prepared)
+		return;
+
+	// tags are separate items in the stream, so the tag of a container is read ahead
+	auto tag = TypeConverter::NoTag;
+	if (_reader->isTag()) {
+		tag = _reader->toTag();
+		_reader->next();
+		checkError();
+	}
+
+	if (_reader->isArray() || _reader->isMap()) {
+		_tag = tag;
+		_type = _reader->isArray() ? QCborValue::Array : QCborValue::Map;
+	} else if (tag == TypeConverter::NoTag && (_bytes = rawByteArray())) {
+		_reader->next();
+		checkError();
+		_tag = tag;
+		_type = QCborValue::ByteArray;
+	} else {
+		// same as QCborValue::fromCbor, including the conversion of tagged extended types
+		_value = tag != TypeConverter::NoTag ?
+					 QCborValue{tag, QCborValue::fromCbor(*_reader)} :
+					 QCborValue::fromCbor(*_reader);
+		checkError();
+		_tag = _value->isTag() ? _value->tag() : TypeConverter::NoTag;
+		_type = _value->isTag() ? _value->taggedValue().type() : _value->type();
+	}
+	_prepared = true;
+}
+
+std::optional<QByteArray> CborValueReader::rawByteArray() const
+{
+	// indefinite length strings are split into chunks, so only definite ones can be referenced
+	if (_rawData.isNull() || !_reader->isByteArray() || !_reader->isLengthKnown())
+		return std::nullopt;
+
+	// the reader only knows the length of the string, so the size of its header is taken from the initial byte
+	const auto offset = _reader->currentOffset();
+	if (offset < 0 || offset >= _rawData.size())
+		return std::nullopt;
+	const auto info = static_cast<uchar>(_rawData[static_cast<int>(offset)]) & 0x1F;
+	qint64 headerSize = 1;
+	if (info >= 24 && info <= 27)
+		headerSize += qint64{1} << (info - 24);
+	else if (info > 27)
+		return std::nullopt;
+
+	const auto length = static_cast<qint64>(_reader->length());
+	if (length > _rawData.size() - offset - headerSize)
+		return std::nullopt;
+	return QByteArray::fromRawData(_rawData.constData() + offset + headerSize, static_cast<int>(length));
+}
+
+void CborValueReader::checkError() const
+{
+	if (const auto error = _reader->lastError(); error.c != QCborError::NoError)
+		throw DeserializationException("Failed to read file as CBOR with error: " + error.toString().toUtf8());
+}
+
+
+
+JsonValueReader::JsonValueReader(QIODevice *device, bool lines) :
+	_device{device},
+	_lines{lines}
+{}
+
+QCborTag JsonValueReader::tag() const
+{
+	return TypeConverter::NoTag;
+}
+
+QCborValue::Type JsonValueReader::type() const
+{
+	prepare();
+	return _type;
+}
+
+qint64 JsonValueReader::length() const
+{
+	return -1;
+}
+
+bool JsonValueReader::hasNext() const
+{
+	if (_prepared)
+		return true;
+	if (_containers.isEmpty()) {
+		if (!_lines)
+			return false;
+		skipSpace();
+		return peek() != -1;
+	}
+
+	const auto &container = _containers.last();
+	// a key is always followed by its value
+	if (container.isMap && container.count % 2 == 1)
+		return true;
+	skipSpace();
+	return peek() != (container.isMap ? '}' : ']');
+}
+
+QCborValue JsonValueReader::read()
+{
+	prepare();
+	if (_value) {
+		_prepared = false;
+		const auto value = *_value;
+		_value.reset();
+		return value;
+	}
+
+	if (_type == QCborValue::Array) {
+		QCborArray array;
+		enterContainer();
+		while (hasNext())
+			array.append(read());
+		leaveContainer();
+		return array;
+	} else {
+		CborMapBuilder map;
+		enterContainer();
+		while (hasNext()) {
+			const auto key = read();
+			map.append(key, read());
+		}
+		leaveContainer();
+		return map.take();
+	}
+}
+
+void JsonValueReader::skip()
+{
+	if (_prepared) {
+		_prepared = false;
+		if (_value) {
+			_value.reset();
+			return;
+		}
+	} else
+		beginValue();
+	skipRaw();
+	endRecord();
+}
+
+void JsonValueReader::enterContainer()
+{
+	prepare();
+	Q_ASSERT_X(!_value, Q_FUNC_INFO, "Only arrays and maps can be entered");
+	if (_containers.size() >= MaxDepth)
+		throwError(QJsonParseError::DeepNesting);
+	_prepared = false;
+	_containers.append({get() == '{'});
+}
+
+void JsonValueReader::leaveContainer()
+{
+	// the remaining elements are only validated, not decoded
+	while (hasNext())
+		skip();
+	const auto container = _containers.takeLast();
+	skipSpace();
+	if (container.isMap)
+		expect('}', QJsonParseError::UnterminatedObject);
+	else
+		expect(']', QJsonParseError::UnterminatedArray);
+	endRecord();
+}
+
+void JsonValueReader::finish()
+{
+	skipSpace();
+	if (peek() != -1)
+		throwError(QJsonParseError::GarbageAtEnd);
+}
+
+void JsonValueReader::prepare() const
+{
+	if (_prepared)
+		return;
+
+	beginValue();
+	switch (peek()) {
+	case '[':
+		_type = QCborValue::Array;
+		break;
+	case '{':
+		_type = QCborValue::Map;
+		break;
+	default:
+		// like QJsonDocument, only objects and arrays are allowed as documents
+		if (_containers.isEmpty() && !_lines)
+			throwError(QJsonParseError::IllegalValue);
+		_value = readScalar();
+		_type = _value->type();
+		endRecord();
+		break;
+	}
+	_prepared = true;
+}
+
+void JsonValueReader::endRecord() const
+{
+	if (_containers.isEmpty())
+		_separated = false;
+}
+
+void JsonValueReader::beginValue() const
+{
+	skipSpace();
+	if (_containers.isEmpty()) {
+		if (_lines && !_separated)
+			throwError(QJsonParseError::GarbageAtEnd);
+	} else {
+		auto &container = _containers.last();
+		if (peek() == -1)
+			throwError(container.isMap ? QJsonParseError::UnterminatedObject : QJsonParseError::UnterminatedArray);
+		if (container.isMap && container.count % 2 == 1)
+			expect(':', QJsonParseError::MissingNameSeparator);
+		else if (container.count > 0)
+			expect(',', QJsonParseError::MissingValueSeparator);
+		skipSpace();
+		if (container.isMap && container.count % 2 == 0 && peek() != '"')
+			throwError(container.count == 0 ? QJsonParseError::UnterminatedObject : QJsonParseError::MissingObject);
+		++container.count;
+	}
+}
+
+QCborValue JsonValueReader::readScalar() const
+{
+	switch (peek()) {
+	case '"':
+		return readString();
+	case 't':
+		readLiteral("true");
+		return true;
+	case 'f':
+		readLiteral("false");
+		return false;
+	case 'n':
+		readLiteral("null");
+		return QCborValue::Null;
+	case '-':
+	case '0': case '1': case '2': case '3': case '4':
+	case '5': case '6': case '7': case '8': case '9':
+		return readNumber();
+	default:
+		throwError(QJsonParseError::IllegalValue);
+	}
+}
+
+QString JsonValueReader::readString() const
+{
+	QString string;
+	scanString(&string);
+	return string;
+}
+
+QCborValue JsonValueReader::readNumber() const
+{
+	QByteArray number;
+	auto isInt = true;
+	const auto appendDigits = [&]() {
+		auto any = false;
+		while (peek() >= '0' && peek() <= '9') {
+			number += static_cast<char>(get());
+			any = true;
+		}
+		if (!any)
+			throwError(QJsonParseError::IllegalNumber);
+	};
+
+	if (peek() == '-')
+		number += static_cast<char>(get());
+	// like RFC 8259 requires, the integer part has no leading zeros
+	if (peek() == '0') {
+		number += static_cast<char>(get());
+		if (peek() >= '0' && peek() <= '9')
+			throwError(QJsonParseError::IllegalNumber);
+	} else
+		appendDigits();
+	if (peek() == '.') {
+		isInt = false;
+		number += static_cast<char>(get());
+		appendDigits();
+	}
+	if (peek() == 'e' || peek() == 'E') {
+		isInt = false;
+		number += static_cast<char>(get());
+		if (peek() == '+' || peek() == '-')
+			number += static_cast<char>(get());
+		appendDigits();
+	}
+
+	// integer literals are kept exact, as long as they fit
+	auto ok = false;
+	if (isInt) {
+		const auto value = number.toLongLong(&ok);
+		if (ok)
+			return value;
+	}
+	const auto value = number.toDouble(&ok);
+	if (!ok)
+		throwError(QJsonParseError::IllegalNumber);
+	return value;
+}
+
+void JsonValueReader::skipRaw() const
+{
+	// skipped values are not decoded, but validated just like the values that are read
+	QVector<bool> isMap;
+	forever {
+		skipSpace();
+		const auto c = peek();
+		if (c == '[' || c == '{') {
+			if (_containers.size() + isMap.size() >= MaxDepth)
+				throwError(QJsonParseError::DeepNesting);
+			++_pos;
+			isMap.append(c == '{');
+			skipSpace();
+			if (peek() != (isMap.last() ? '}' : ']')) {
+				if (isMap.last())
+					skipKey(true);
+				continue;
+			}
+			++_pos;
+			isMap.removeLast();
+		} else if (c == '"')
+			skipString();
+		else
+			readScalar();
+
+		// the value is complete, so the containers it is part of either continue or end
+		forever {
+			if (isMap.isEmpty())
+				return;
+			skipSpace();
+			const auto next = get();
+			if (next == ',') {
+				if (isMap.last())
+					skipKey(false);
+				break;
+			} else if (next == (isMap.last() ? '}' : ']'))
+				isMap.removeLast();
+			else if (next == -1)
+				throwError(isMap.last() ? QJsonParseError::UnterminatedObject : QJsonParseError::UnterminatedArray);
+			else
+				throwError(QJsonParseError::MissingValueSeparator);
+		}
+	}
+}
+
+void JsonValueReader::skipKey(bool first) const
+{
+	skipSpace();
+	if (peek() != '"')
+		throwError(first ? QJsonParseError::UnterminatedObject : QJsonParseError::MissingObject);
+	skipString();
+	skipSpace();
+	expect(':', QJsonParseError::MissingNameSeparator);
+}
+
+void JsonValueReader::skipString() const
+{
+	scanString(nullptr);
+}
+
+void JsonValueReader::scanString(QString *string) const
+{
+	get();  // the opening quote
+	// unescaped text is collected as UTF-8 and only decoded when an escape sequence or the end is reached
+	QByteArray utf8;
+	const auto flush = [&]() {
+		if (string && !utf8.isEmpty()) {
+			*string += QString::fromUtf8(utf8);
+			utf8.clear();
+		}
+	};
+
+	forever {
+		const auto c = get();
+		if (c == -1)
+			throwError(QJsonParseError::UnterminatedString);
+		else if (c == '"') {
+			flush();
+			return;
+		} else if (c == '\\') {
+			flush();
+			const auto unit = readEscape();
+			if (QChar::isHighSurrogate(unit)) {
+				// characters beyond the BMP must be escaped as a complete surrogate pair
+				if (get() != '\\')
+					throwError(QJsonParseError::IllegalEscapeSequence);
+				const auto low = readEscape();
+				if (!QChar::isLowSurrogate(low))
+					throwError(QJsonParseError::IllegalEscapeSequence);
+				if (string) {
+					string->append(QChar{unit});
+					string->append(QChar{low});
+				}
+			} else if (QChar::isLowSurrogate(unit))
+				throwError(QJsonParseError::IllegalEscapeSequence);
+			else if (string)
+				string->append(QChar{unit});
+		} else if (c < 0x20)  // control characters must be escaped
+			throwError(QJsonParseError::IllegalValue);
+		else if (c < 0x80) {
+			if (string)
+				utf8 += static_cast<char>(c);
+		} else
+			readUtf8(c, string ? &utf8 : nullptr);
+	}
+}
+
+ushort JsonValueReader::readEscape() const
+{
+	switch (get()) {
+	case '"':
+		return '"';
+	case '\\':
+		return '\\';
+	case '/':
+		return '/';
+	case 'b':
+		return '\b';
+	case 'f':
+		return '\f';
+	case 'n':
+		return '\n';
+	case 'r':
+		return '\r';
+	case 't':
+		return '\t';
+	case 'u': {
+		ushort unit = 0;
+		for (auto i = 0; i < 4; ++i) {
+			const auto digit = get();
+			unit <<= 4;
+			if (digit >= '0' && digit <= '9')
+				unit |= static_cast<ushort>(digit - '0');
+			else if (digit >= 'a' && digit <= 'f')
+				unit |= static_cast<ushort>(digit - 'a' + 10);
+			else if (digit >= 'A' && digit <= 'F')
+				unit |= static_cast<ushort>(digit - 'A' + 10);
+			else
+				throwError(QJsonParseError::IllegalEscapeSequence);
+		}
+		return unit;
+	}
+	default:
+		throwError(QJsonParseError::IllegalEscapeSequence);
+	}
+}
+
+void JsonValueReader::readUtf8(int lead, QByteArray *utf8) const
+{
+	// only well formed UTF-8 is accepted: no overlong forms, no surrogates and nothing beyond U+10FFFF
+	auto length = 0;
+	uint code = 0;
+	uint minCode = 0;
+	if ((lead & 0xE0) == 0xC0) {
+		length = 2;
+		code = static_cast<uint>(lead & 0x1F);
+		minCode = 0x80;
+	} else if ((lead & 0xF0) == 0xE0) {
+		length = 3;
+		code = static_cast<uint>(lead & 0x0F);
+		minCode = 0x800;
+	} else if ((lead & 0xF8) == 0xF0) {
+		length = 4;
+		code = static_cast<uint>(lead & 0x07);
+		minCode = 0x10000;
+	} else
+		throwError(QJsonParseError::IllegalUTF8String);
+
+	if (utf8)
+		*utf8 += static_cast<char>(lead);
+	for (auto i = 1; i < length; ++i) {
+		const auto c = get();
+		if (c == -1 || (c & 0xC0) != 0x80)
+			throwError(QJsonParseError::IllegalUTF8String);
+		code = (code << 6) | static_cast<uint>(c & 0x3F);
+		if (utf8)
+			*utf8 += static_cast<char>(c);
+	}
+	if (code < minCode || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+		throwError(QJsonParseError::IllegalUTF8String);
+}
+
+void JsonValueReader::readLiteral(const char *literal) const
+{
+	for (auto c = literal; *c; ++c) {
+		if (get() != *c)
+			throwError(QJsonParseError::IllegalValue);
+	}
+}
+
+int JsonValueReader::peek() const
+{
+	if (_pos >= _buffer.size()) {
+		_offset += _buffer.size();
+		_buffer = _device->read(ChunkSize);
+		_pos = 0;
+		if (_buffer.isEmpty())
+			return -1;
+	}
+	return static_cast<uchar>(_buffer.at(_pos));
+}
+
+int JsonValueReader::get() const
+{
+	const auto c = peek();
+	if (c != -1)
+		++_pos;
+	return c;
+}
+
+void JsonValueReader::expect(char c, QJsonParseError::ParseError error) const
+{
+	if (get() != c)
+		throwError(error);
+}
+
+void JsonValueReader::skipSpace() const
+{
+	forever {
+		switch (peek()) {
+		case '\n':
+			_separated = true;
+			Q_FALLTHROUGH();
+		case ' ':
+		case '\t':
+		case '\r':
+			++_pos;
+			break;
+		default:
+			return;
+		}
+	}
+}
+
+void JsonValueReader::throwError(QJsonParseError::ParseError error) const
+{
+	QJsonParseError parseError;
+	parseError.error = error;
+	parseError.offset = static_cast<int>(_offset + _pos);
+	throw DeserializationException{"Failed to read file as JSON with error: " + parseError.errorString().toUtf8()};
+}
@@ -0,0 +1,43 @@
+#ifndef QTJSONSERIALIZER_VALUEREADER_H
+#define QTJSONSERIALIZER_VALUEREADER_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+
+#include <QtCore/qcborvalue.h>
+
+namespace QtJsonSerializer {
+
+//! A source of serialized data, that lets type converters consume values without building a CBOR tree
+class Q_JSONSERIALIZER_EXPORT ValueReader
+{
+	Q_DISABLE_COPY(ValueReader)
+
+public:
+	virtual ~ValueReader();
+
+	//! Returns the tag of the current value, or TypeConverter::NoTag if it has none
+	virtual QCborTag tag() const = 0;
+	//! Returns the type of the current value, with the tag already removed
+	virtual QCborValue::Type type() const = 0;
+	//! Returns the number of elements or key-value pairs of the current array or map, or -1 if unknown
+	virtual qint64 length() const = 0;
+	//! Checks if the current array or map has more elements to be read
+	virtual bool hasNext() const = 0;
+
+	//! Reads the complete current value, including its tag, and moves on to the next one
+	virtual QCborValue read() = 0;
+	//! Moves on to the next value, without reading the current one
+	virtual void skip();
+	//! Enters the current array or map, so its elements become the values to be read
+	virtual void enterContainer() = 0;
+	//! Skips the remaining elements of the entered container and moves on to the value after it
+	virtual void leaveContainer() = 0;
+
+protected:
+	//! Default constructor
+	ValueReader();
+};
+
+}
+
+#endif // QTJSONSERIALIZER_VALUEREADER_H
@@ -0,0 +1,129 @@
+#ifndef QTJSONSERIALIZER_VALUEREADER_P_H
+#define QTJSONSERIALIZER_VALUEREADER_P_H
+
+#include "valuereader.h"
+#include "typeconverter.h"
+
+#include <optional>
+
+#include <QtCore/QCborStreamReader>
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonParseError>
+#include <QtCore/QVector>
+
+namespace QtJsonSerializer {
+
+// container lengths are read from the untrusted data, so they only limit how much is reserved up front
+constexpr qint64 MaxReservedLength = 1024;
+inline int reservedLength(qint64 length) {
+	return static_cast<int>(qBound<qint64>(0, length, MaxReservedLength));
+}
+
+class Q_JSONSERIALIZER_EXPORT CborValueReader : public ValueReader
+{
+public:
+	explicit CborValueReader(QCborStreamReader *reader);
+
+	QCborTag tag() const override;
+	QCborValue::Type type() const override;
+	qint64 length() const override;
+	bool hasNext() const override;
+
+	QCborValue read() override;
+	void skip() override;
+	void enterContainer() override;
+	void leaveContainer() override;
+
+	// untagged byte strings reference rawData instead of being copied, which must be what the reader reads
+	void setRawData(const QByteArray &rawData);
+	// returns the current byte string as reference into the raw data, if it is one
+	std::optional<QByteArray> takeRawByteArray();
+	bool isRawDataReferenced() const;
+
+private:
+	QCborStreamReader *_reader;
+	QByteArray _rawData;
+	bool _rawDataReferenced = false;
+	// the current value is inspected lazily, so nothing beyond the requested data is read
+	mutable bool _prepared = false;
+	mutable QCborTag _tag = TypeConverter::NoTag;
+	mutable QCborValue::Type _type = QCborValue::Invalid;
+	// everything but arrays and maps is read completely when inspected
+	mutable std::optional<QCborValue> _value;
+	mutable std::optional<QByteArray> _bytes;
+
+	void prepare() const;
+	std::optional<QByteArray> rawByteArray() const;
+	void checkError() const;
+};
+
+class Q_JSONSERIALIZER_EXPORT JsonValueReader : public ValueReader
+{
+public:
+	// with lines set, any value can be read as document, and multiple documents can follow each other
+	explicit JsonValueReader(QIODevice *device, bool lines = false);
+
+	QCborTag tag() const override;
+	QCborValue::Type type() const override;
+	qint64 length() const override;
+	bool hasNext() const override;
+
+	QCborValue read() override;
+	void skip() override;
+	void enterContainer() override;
+	void leaveContainer() override;
+
+	// verifies that nothing but whitespace follows the document
+	void finish();
+
+private:
+	struct Container {
+		bool isMap;
+		// for maps, keys and values are counted separately
+		qint64 count = 0;
+	};
+
+	// the device is read in chunks of this size, so the document never has to be in memory completely
+	static constexpr qint64 ChunkSize = 16 * 1024;
+	// same as QJsonDocument, to protect the stack of the deserializer
+	static constexpr int MaxDepth = 1024;
+
+	QIODevice *_device;
+	bool _lines;
+	mutable QByteArray _buffer;
+	mutable int _pos = 0;
+	mutable qint64 _offset = 0;
+	mutable QVector<Container> _containers;
+	// with lines set, each record must start on a new line
+	mutable bool _separated = true;
+
+	mutable bool _prepared = false;
+	mutable QCborValue::Type _type = QCborValue::Invalid;
+	// everything but arrays and maps is read completely when inspected
+	mutable std::optional<QCborValue> _value;
+
+	void prepare() const;
+	void beginValue() const;
+	void endRecord() const;
+	QCborValue readScalar() const;
+	void skipRaw() const;
+	void skipKey(bool first) const;
+	void skipString() const;
+	QString readString() const;
+	// validates the string, and decodes it into string unless that is nullptr
+	void scanString(QString *string) const;
+	ushort readEscape() const;
+	void readUtf8(int lead, QByteArray *utf8) const;
+	QCborValue readNumber() const;
+	void readLiteral(const char *literal) const;
+
+	int peek() const;
+	int get() const;
+	void expect(char c, QJsonParseError::ParseError error) const;
+	void skipSpace() const;
+	[[noreturn]] void throwError(QJsonParseError::ParseError error) const;
+};
+
+}
+
+#endif // QTJSONSERIALIZER_VALUEREADER_P_H
@@ -0,0 +1,389 @@
+#include "valuewriter.h"
+#include "valuewriter_p.h"
+#include "exception.h"
+
+#include <cmath>
+
+#include <QtCore/QLocale>
+using namespace QtJsonSerializer;
+
+ValueWriter::ValueWriter() :
+	d{new ValueWriterPrivate{}}
+{}
+
+ValueWriter::~ValueWriter() = default;
+
+void ValueWriter::appendTag(QCborTag tag)
+{
+	if (tag == TypeConverter::NoTag)
+		return;
+	// the override takes the place of the first tag
+	if (d->overrideTag != TypeConverter::NoTag && !d->overrideConsumed) {
+		d->overrideConsumed = true;
+		return;
+	}
+	// a tag that is already pending belongs to an outer value
+	if (d->pendingTag != TypeConverter::NoTag)
+		beginValue();
+	d->pendingTag = tag;
+}
+
+void ValueWriter::append(const QCborValue &value)
+{
+	// values without a separate tag get their own tag replaced, just like serializeVariant does it
+	const auto stripTag = d->overrideTag != TypeConverter::NoTag &&
+						  !d->overrideConsumed &&
+						  value.isTag();
+	beginValue();
+	writeValue(stripTag ? value.taggedValue() : value);
+}
+
+void ValueWriter::startArray(qint64 count)
+{
+	beginValue();
+	writeStartArray(count);
+}
+
+void ValueWriter::endArray()
+{
+	writeEndArray();
+}
+
+void ValueWriter::startMap(qint64 count)
+{
+	beginValue();
+	writeStartMap(count);
+}
+
+void ValueWriter::endMap()
+{
+	writeEndMap();
+}
+
+void ValueWriter::overrideTag(QCborTag tag)
+{
+	if (d->overrideTag != TypeConverter::NoTag) {
+		// an unused override of an outer value replaces this one as well
+		if (!d->overrideConsumed)
+			return;
+		beginValue();
+	}
+	d->overrideTag = tag;
+	d->overrideConsumed = false;
+}
+
+void ValueWriter::resetTags()
+{
+	d->pendingTag = TypeConverter::NoTag;
+	d->overrideTag = TypeConverter::NoTag;
+	d->overrideConsumed = false;
+}
+
+void ValueWriter::beginValue()
+{
+	if (d->overrideTag != TypeConverter::NoTag) {
+		writeTag(d->overrideTag);
+		d->overrideTag = TypeConverter::NoTag;
+		d->overrideConsumed = false;
+	}
+	if (d->pendingTag != TypeConverter::NoTag) {
+		writeTag(d->pendingTag);
+		d->pendingTag = TypeConverter::NoTag;
+	}
+}
+
+// ------------- private implementation -------------
+
+CborValueWriter::CborValueWriter(QCborStreamWriter *writer, QCborValue::EncodingOptions options) :
+	_writer{writer},
+	_options{options}
+{}
+
+void CborValueWriter::writeTag(QCborTag tag)
+{
+	_writer->append(tag);
+}
+
+void CborValueWriter::writeValue(const QCborValue &value)
+{
+	value.toCbor(*_writer, _options);
+}
+
+void CborValueWriter::writeStartArray(qint64 count)
+{
+	if (count < 0)
+		_writer->startArray();
+	else
+		_writer->startArray(static_cast<quint64>(count));
+}
+
+void CborValueWriter::writeEndArray()
+{
+	_writer->endArray();
+}
+
+void CborValueWriter::writeStartMap(qint64 count)
+{
+	if (count < 0)
+		_writer->startMap();
+	else
+		_writer->startMap(static_cast<quint64>(count));
+}
+
+void CborValueWriter::writeEndMap()
+{
+	_writer->endMap();
+}
+
+
+
+JsonValueWriter::JsonValueWriter(QIODevice *device, QJsonDocument::JsonFormat format, bool lines) :
+	_device{device},
+	_compact{format == QJsonDocument::Compact},
+	_lines{lines}
+{}
+
+void JsonValueWriter::flush()
+{
+	if (_buffer.isEmpty())
+		return;
+	_device->write(_buffer);
+	_buffer.clear();
+	_recordStart = 0;
+}
+
+void JsonValueWriter::discardRecord()
+{
+	Q_ASSERT_X(_lines, Q_FUNC_INFO, "Only records of JSON lines are kept until complete");
+	_buffer.truncate(_recordStart);
+	_containers.clear();
+	_tags.clear();
+	resetTags();
+}
+
+void JsonValueWriter::writeTag(QCborTag tag)
+{
+	_tags.append(tag);
+}
+
+void JsonValueWriter::writeValue(const QCborValue &value)
+{
+	auto jValue = value;
+	for (auto it = _tags.crbegin(); it != _tags.crend(); ++it)
+		jValue = QCborValue{*it, jValue};
+	_tags.clear();
+
+	switch (jValue.type()) {
+	case QCborValue::Array: {
+		const auto array = jValue.toArray();
+		writeStartArray(array.size());
+		for (const auto &element : array)
+			writeValue(element);
+		writeEndArray();
+		break;
+	}
+	case QCborValue::Map: {
+		const auto map = jValue.toMap();
+		writeStartMap(map.size());
+		for (const auto entry : map) {
+			writeValue(entry.first);
+			writeValue(entry.second);
+		}
+		writeEndMap();
+		break;
+	}
+	case QCborValue::Integer:
+	case QCborValue::Double:
+	case QCborValue::String:
+	case QCborValue::False:
+	case QCborValue::True:
+	case QCborValue::Null:
+		if (_containers.isEmpty() && !_lines)
+			throw SerializationException{"Only objects or arrays can be written to a device!"};
+		if (isKeyExpected())
+			writeKey(jValue);
+		else {
+			beginItem();
+			writeScalar(jValue);
+			endItem();
+		}
+		break;
+	default: {
+		// tagged and extended values are converted the same way QCborValue::toJsonValue does it
+		const auto converted = QCborValue::fromJsonValue(jValue.toJsonValue());
+		writeValue(converted.isUndefined() ? QCborValue{QCborValue::Null} : converted);
+		break;
+	}
+	}
+}
+
+void JsonValueWriter::writeStartArray(qint64 count)
+{
+	Q_UNUSED(count)
+	_tags.clear();
+	beginItem();
+	_buffer += _compact ? "[" : "[\n";
+	_containers.append({false});
+}
+
+void JsonValueWriter::writeEndArray()
+{
+	const auto container = _containers.takeLast();
+	if (container.count > 0 && !_compact)
+		_buffer += '\n';
+	writeIndent(_containers.size());
+	_buffer += ']';
+	endItem();
+}
+
+void JsonValueWriter::writeStartMap(qint64 count)
+{
+	Q_UNUSED(count)
+	_tags.clear();
+	beginItem();
+	_buffer += _compact ? "{" : "{\n";
+	_containers.append({true});
+}
+
+void JsonValueWriter::writeEndMap()
+{
+	const auto container = _containers.takeLast();
+	if (container.count > 0 && !_compact)
+		_buffer += '\n';
+	writeIndent(_containers.size());
+	_buffer += '}';
+	endItem();
+}
+
+bool JsonValueWriter::isKeyExpected() const
+{
+	return !_containers.isEmpty() &&
+			_containers.last().isMap &&
+			_containers.last().count % 2 == 0;
+}
+
+void JsonValueWriter::beginItem()
+{
+	if (_containers.isEmpty())
+		return;
+	auto &container = _containers.last();
+	if (container.isMap) {
+		if (container.count % 2 == 0)
+			throw SerializationException{"Only simple values can be used as keys of a JSON object"};
+		// the separator has already been written together with the key
+		++container.count;
+		return;
+	}
+
+	if (container.count > 0)
+		_buffer += _compact ? "," : ",\n";
+	writeIndent(_containers.size());
+	++container.count;
+}
+
+void JsonValueWriter::endItem()
+{
+	if (_containers.isEmpty()) {
+		if (_lines) {
+			// records are collected, as they are typically much smaller than a chunk
+			_buffer += '\n';
+			_recordStart = _buffer.size();
+			if (_buffer.size() >= ChunkSize)
+				flush();
+		} else {
+			if (!_compact)
+				_buffer += '\n';
+			flush();
+		}
+	} else if (!_lines && _buffer.size() >= ChunkSize)
+		flush();
+}
+
+void JsonValueWriter::writeScalar(const QCborValue &value)
+{
+	switch (value.type()) {
+	case QCborValue::Integer:
+		_buffer += QByteArray::number(value.toInteger());
+		break;
+	case QCborValue::Double: {
+		const auto number = value.toDouble();
+		if (std::isfinite(number))
+			_buffer += QByteArray::number(number, 'g', QLocale::FloatingPointShortest);
+		else
+			_buffer += "null";  // +INF || -INF || NaN (see RFC4627#section2.4)
+		break;
+	}
+	case QCborValue::String:
+		writeString(value.toString());
+		break;
+	case QCborValue::False:
+		_buffer += "false";
+		break;
+	case QCborValue::True:
+		_buffer += "true";
+		break;
+	default:
+		_buffer += "null";
+		break;
+	}
+}
+
+void JsonValueWriter::writeKey(const QCborValue &key)
+{
+	auto &container = _containers.last();
+	if (container.count > 0)
+		_buffer += _compact ? "," : ",\n";
+	writeIndent(_containers.size());
+	if (key.isString())
+		writeString(key.toString());
+	else  // other keys are converted to strings the same way QCborMap::toJsonObject does it
+		writeString(QCborMap{{key, QCborValue::Null}}.toJsonObject().constBegin().key());
+	_buffer += _compact ? ":" : ": ";
+	++container.count;
+}
+
+void JsonValueWriter::writeString(const QString &string)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+	_buffer += '"';
+	for (const auto c : string.toUtf8()) {
+		switch (c) {
+		case '"':
+			_buffer += "\\\"";
+			break;
+		case '\\':
+			_buffer += "\\\\";
+			break;
+		case '\b':
+			_buffer += "\\b";
+			break;
+		case '\f':
+			_buffer += "\\f";
+			break;
+		case '\n':
+			_buffer += "\\n";
+			break;
+		case '\r':
+			_buffer += "\\r";
+			break;
+		case '\t':
+			_buffer += "\\t";
+			break;
+		default:
+			if (static_cast<uchar>(c) < 0x20) {
+				_buffer += "\\u00";
+				_buffer += hexDigits[(c >> 4) & 0xf];
+				_buffer += hexDigits[c & 0xf];
+			} else
+				_buffer += c;
+			break;
+		}
+	}
+	_buffer += '"';
+}
+
+void JsonValueWriter::writeIndent(int level)
+{
+	if (!_compact)
+		_buffer.append(4 * level, ' ');
+}
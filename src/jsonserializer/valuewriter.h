@@ -0,0 +1,64 @@
+#ifndef QTJSONSERIALIZER_VALUEWRITER_H
+#define QTJSONSERIALIZER_VALUEWRITER_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qscopedpointer.h>
+
+namespace QtJsonSerializer {
+
+class ValueWriterPrivate;
+//! A sink for serialized data, that lets type converters emit values without building a CBOR tree
+class Q_JSONSERIALIZER_EXPORT ValueWriter
+{
+	Q_DISABLE_COPY(ValueWriter)
+
+public:
+	virtual ~ValueWriter();
+
+	//! Tags the next value that is written
+	void appendTag(QCborTag tag);
+	//! Writes a complete value
+	void append(const QCborValue &value);
+	//! Starts an array with count elements, or of unknown size if count is -1
+	void startArray(qint64 count = -1);
+	//! Ends the array that was started last
+	void endArray();
+	//! Starts a map with count key-value pairs, or of unknown size if count is -1
+	void startMap(qint64 count = -1);
+	//! Ends the map that was started last
+	void endMap();
+
+	//! @private
+	void overrideTag(QCborTag tag);
+
+protected:
+	//! Default constructor
+	ValueWriter();
+
+	//! Writes a tag for the following value
+	virtual void writeTag(QCborTag tag) = 0;
+	//! Writes a complete value
+	virtual void writeValue(const QCborValue &value) = 0;
+	//! Writes the start of an array
+	virtual void writeStartArray(qint64 count) = 0;
+	//! Writes the end of an array
+	virtual void writeEndArray() = 0;
+	//! Writes the start of a map
+	virtual void writeStartMap(qint64 count) = 0;
+	//! Writes the end of a map
+	virtual void writeEndMap() = 0;
+
+	//! Drops tags that were appended for a value that was never written
+	void resetTags();
+
+private:
+	QScopedPointer<ValueWriterPrivate> d;
+
+	void beginValue();
+};
+
+}
+
+#endif // QTJSONSERIALIZER_VALUEWRITER_H
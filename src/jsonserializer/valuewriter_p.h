@@ -0,0 +1,90 @@
+#ifndef QTJSONSERIALIZER_VALUEWRITER_P_H
+#define QTJSONSERIALIZER_VALUEWRITER_P_H
+
+#include "valuewriter.h"
+#include "typeconverter.h"
+
+#include <QtCore/QCborStreamWriter>
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QVector>
+
+namespace QtJsonSerializer {
+
+class ValueWriterPrivate
+{
+public:
+	QCborTag pendingTag = TypeConverter::NoTag;
+	// replaces the first tag of the next value, set by the serializer for explicit type tags
+	QCborTag overrideTag = TypeConverter::NoTag;
+	bool overrideConsumed = false;
+};
+
+class Q_JSONSERIALIZER_EXPORT CborValueWriter : public ValueWriter
+{
+public:
+	CborValueWriter(QCborStreamWriter *writer, QCborValue::EncodingOptions options);
+
+protected:
+	void writeTag(QCborTag tag) override;
+	void writeValue(const QCborValue &value) override;
+	void writeStartArray(qint64 count) override;
+	void writeEndArray() override;
+	void writeStartMap(qint64 count) override;
+	void writeEndMap() override;
+
+private:
+	QCborStreamWriter *_writer;
+	QCborValue::EncodingOptions _options;
+};
+
+class Q_JSONSERIALIZER_EXPORT JsonValueWriter : public ValueWriter
+{
+public:
+	// with lines set, any value can be written as document, and each one is terminated by a newline
+	JsonValueWriter(QIODevice *device, QJsonDocument::JsonFormat format, bool lines = false);
+
+	void flush();
+	// drops the incomplete record, only possible with lines set, as records are then only flushed once complete
+	void discardRecord();
+
+protected:
+	void writeTag(QCborTag tag) override;
+	void writeValue(const QCborValue &value) override;
+	void writeStartArray(qint64 count) override;
+	void writeEndArray() override;
+	void writeStartMap(qint64 count) override;
+	void writeEndMap() override;
+
+private:
+	struct Container {
+		bool isMap;
+		// for maps, keys and values are counted separately
+		qint64 count = 0;
+	};
+
+	// text is collected into chunks of this size, as many small writes are expensive for most devices
+	static constexpr int ChunkSize = 16 * 1024;
+
+	QIODevice *_device;
+	bool _compact;
+	bool _lines;
+	QByteArray _buffer;
+	// the size of _buffer before the current record was started
+	int _recordStart = 0;
+	QVector<Container> _containers;
+	// tags do not exist in JSON, they only affect how the tagged value is converted
+	QVector<QCborTag> _tags;
+
+	bool isKeyExpected() const;
+	void beginItem();
+	void endItem();
+	void writeScalar(const QCborValue &value);
+	void writeKey(const QCborValue &key);
+	void writeString(const QString &string);
+	void writeIndent(int level);
+};
+
+}
+
+#endif // QTJSONSERIALIZER_VALUEWRITER_P_H
@@ -21,6 +21,8 @@ protected:
 
 private:
 	ListConverter _converter;
+
+	static QCborTag typedArrayTag(quint64 bigEndianTag);
 };
 
 void ListConverterTest::initTest()
@@ -36,6 +38,14 @@ void ListConverterTest::initTest()
 	QMetaType::registerEqualsComparator<QSet<int>>();
 }
 
+QCborTag ListConverterTest::typedArrayTag(quint64 bigEndianTag)
+{
+	// the converter writes typed arrays in host byte order
+	if (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+		bigEndianTag |= 0x04;
+	return static_cast<QCborTag>(bigEndianTag);
+}
+
 TypeConverter *ListConverterTest::converter()
 {
 	return &_converter;
@@ -119,6 +129,32 @@ void ListConverterTest::addMetaData()
 									 << QCborValue::Array
 									 << true
 									 << TypeConverter::DeserializationCapabilityResult::Positive;
+
+	QTest::newRow("typedArray.host") << qMetaTypeId<QVector<int>>()
+									 << typedArrayTag(0x4A)
+									 << QCborValue::ByteArray
+									 << true
+									 << TypeConverter::DeserializationCapabilityResult::Positive;
+	QTest::newRow("typedArray.bigEndian") << qMetaTypeId<QList<int>>()
+										  << static_cast<QCborTag>(0x4A)
+										  << QCborValue::ByteArray
+										  << true
+										  << TypeConverter::DeserializationCapabilityResult::Positive;
+	QTest::newRow("typedArray.littleEndian") << qMetaTypeId<QList<int>>()
+											 << static_cast<QCborTag>(0x4E)
+											 << QCborValue::ByteArray
+											 << true
+											 << TypeConverter::DeserializationCapabilityResult::Positive;
+	QTest::newRow("typedArray.wrongTag") << qMetaTypeId<QVector<int>>()
+										 << static_cast<QCborTag>(0x52)
+										 << QCborValue::ByteArray
+										 << true
+										 << TypeConverter::DeserializationCapabilityResult::WrongTag;
+	QTest::newRow("typedArray.array") << qMetaTypeId<QVector<int>>()
+									  << typedArrayTag(0x4A)
+									  << QCborValue::Array
+									  << true
+									  << TypeConverter::DeserializationCapabilityResult::Negative;
 }
 
 void ListConverterTest::addCommonSerData()
@@ -216,6 +252,24 @@ void ListConverterTest::addCommonSerData()
 							 << QCborValue{static_cast<QCborTag>(CborSerializer::Set), QCborArray{2, 4, 6}}
 							 << QJsonValue{QJsonArray{2, 4, 6}};
 	}
+
+	{
+		const QVector<int> v{1, -2, 3};
+		QTest::newRow("typedArray.vector") << QVariantHash{{QStringLiteral("typedArrays"), true}}
+										   << TestQ{}
+										   << static_cast<QObject*>(this)
+										   << qMetaTypeId<QVector<int>>()
+										   << QVariant::fromValue(v)
+										   << QCborValue{typedArrayTag(0x4A), QByteArray{reinterpret_cast<const char*>(v.constData()), v.size() * static_cast<int>(sizeof(int))}}
+										   << QJsonValue{QJsonValue::Undefined};
+		QTest::newRow("typedArray.list") << QVariantHash{{QStringLiteral("typedArrays"), true}}
+										 << TestQ{}
+										 << static_cast<QObject*>(this)
+										 << qMetaTypeId<QList<int>>()
+										 << QVariant::fromValue(v.toList())
+										 << QCborValue{typedArrayTag(0x4A), QByteArray{reinterpret_cast<const char*>(v.constData()), v.size() * static_cast<int>(sizeof(int))}}
+										 << QJsonValue{QJsonValue::Undefined};
+	}
 }
 
 void ListConverterTest::addDeserData()
@@ -239,6 +293,34 @@ void ListConverterTest::addDeserData()
 									<< QVariant::fromValue(s)
 									<< QCborValue{static_cast<QCborTag>(CborSerializer::Homogeneous), QCborArray{2, 4, 6}}
 									<< QJsonValue{QJsonArray{2, 4, 6}};
+	QTest::newRow("typedArray.bigEndian") << QVariantHash{}
+										  << TestQ{}
+										  << static_cast<QObject*>(this)
+										  << qMetaTypeId<QVector<int>>()
+										  << QVariant::fromValue(QVector<int>{1, -2})
+										  << QCborValue{static_cast<QCborTag>(0x4A), QByteArray{"\x00\x00\x00\x01\xff\xff\xff\xfe", 8}}
+										  << QJsonValue{QJsonValue::Undefined};
+	QTest::newRow("typedArray.littleEndian") << QVariantHash{}
+											 << TestQ{}
+											 << static_cast<QObject*>(this)
+											 << qMetaTypeId<QList<int>>()
+											 << QVariant::fromValue(QList<int>{1, -2})
+											 << QCborValue{static_cast<QCborTag>(0x4E), QByteArray{"\x01\x00\x00\x00\xfe\xff\xff\xff", 8}}
+											 << QJsonValue{QJsonValue::Undefined};
+	QTest::newRow("typedArray.wrongTag") << QVariantHash{}
+										 << TestQ{}
+										 << static_cast<QObject*>(this)
+										 << qMetaTypeId<QVector<int>>()
+										 << QVariant{}
+										 << QCborValue{static_cast<QCborTag>(0x52), QByteArray{"\x00\x00\x00\x01", 4}}
+										 << QJsonValue{QJsonValue::Undefined};
+	QTest::newRow("typedArray.size") << QVariantHash{}
+									 << TestQ{}
+									 << static_cast<QObject*>(this)
+									 << qMetaTypeId<QVector<int>>()
+									 << QVariant{}
+									 << QCborValue{static_cast<QCborTag>(0x4A), QByteArray{"\x00\x00\x01", 3}}
+									 << QJsonValue{QJsonValue::Undefined};
 	QTest::newRow("unwritable") << QVariantHash{}
 								<< TestQ{}
 								<< static_cast<QObject*>(nullptr)
@@ -1,5 +1,6 @@
 #include "testconverter.h"
 #include <QCborMap>
+#include <QtJsonSerializer/exception.h>
 using namespace QtJsonSerializer;
 
 bool EnumContainer::operator==(EnumContainer other) const
@@ -25,6 +26,19 @@ void EnumContainer::setEnumFlags(EnumFlags value)
 }
 
 
+bool TestGadget::operator==(const TestGadget &other) const
+{
+	return id == other.id &&
+		   name == other.name;
+}
+
+bool TestGadget::operator!=(const TestGadget &other) const
+{
+	return id != other.id ||
+		   name != other.name;
+}
+
+
 
 TestEnumConverter::TestEnumConverter()
 {
@@ -91,6 +105,8 @@ QCborValue TestWrapperConverter::serialize(int propertyType, const QVariant &val
 	Q_UNUSED(propertyType)
 	auto mo = &EnumContainer::staticMetaObject;
 	auto container = value.value<EnumContainer>();
+	if (container.normalEnum == EnumContainer::Normal0)
+		throw SerializationException{"Normal0 cannot be serialized"};
 	return QCborMap {
 		{QStringLiteral("0"), helper()->serializeSubtype(mo->property(mo->propertyOffset()), static_cast<int>(container.normalEnum))},
 		{QStringLiteral("1"), helper()->serializeSubtype(mo->property(mo->propertyOffset() + 1), static_cast<int>(container.enumFlags))}
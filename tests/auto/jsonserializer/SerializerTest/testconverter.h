@@ -40,6 +40,21 @@ private:
 	void setEnumFlags(EnumFlags value);
 };
 
+class TestGadget
+{
+	Q_GADGET
+
+	Q_PROPERTY(int id MEMBER id)
+	Q_PROPERTY(QString name MEMBER name)
+
+public:
+	int id = 0;
+	QString name;
+
+	bool operator==(const TestGadget &other) const;
+	bool operator!=(const TestGadget &other) const;
+};
+
 class TestEnumConverter : public QtJsonSerializer::TypeConverter
 {
 public:
@@ -78,5 +93,6 @@ public:
 Q_DECLARE_OPERATORS_FOR_FLAGS(EnumContainer::EnumFlags)
 
 Q_DECLARE_METATYPE(EnumContainer)
+Q_DECLARE_METATYPE(TestGadget)
 
 #endif // TESTCONVERTER_H
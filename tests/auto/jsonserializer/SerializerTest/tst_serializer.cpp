@@ -35,6 +35,15 @@ private Q_SLOTS:
 	void testDeserialization();
 
 	void testDeviceSerialization();
+	void testJsonLines();
+	void testCborSequence();
+	void testSequenceSerialization();
+	void testPartialDeserialization();
+	void testStaticPath();
+	void testDeserializeInto();
+	void testContainerReaders();
+	void testKeyCollisions();
+	void testIncrementalDeserialization();
 	void testExceptionTrace();
 
 private:
@@ -42,6 +51,7 @@ private:
 	CborSerializer *cborSerializer = nullptr;
 
 	void addCommonData();
+	static std::pair<EnumContainer, EnumContainer> testRecords();
 	void resetProps();
 };
 
@@ -50,10 +60,13 @@ void SerializerTest::initTestCase()
 	// converters
 	JsonSerializer::registerPointerConverters<TestObject>();
 	JsonSerializer::registerListConverters<TestObject*>();
+	JsonSerializer::registerListConverters<EnumContainer>();
+	JsonSerializer::registerListConverters<QLocale::Language>();
 	JsonSerializer::registerListConverters<QList<int>>();
 	JsonSerializer::registerMapConverters<QString, TestObject*>();
 	JsonSerializer::registerMapConverters<QString, QMap<QString, int>>();
 	JsonSerializer::registerMapConverters<int, double>();
+	JsonSerializer::registerMapConverters<QDateTime, int>();
 	JsonSerializer::registerPairConverters<int, QString>();
 	JsonSerializer::registerPairConverters<bool, bool>();
 	JsonSerializer::registerPairConverters<QList<bool>, bool>();
@@ -332,6 +345,13 @@ void SerializerTest::testVariantConversions()
 			for (const auto &vData : variantList)
 				writer->add(vData);
 			QCOMPARE(res, data);
+
+			// in place writers take the elements all at once
+			QVariant rangeRes{data.userType(), nullptr};
+			ScopedWriter<SequentialWriter> rangeWriter;
+			QVERIFY(SequentialWriter::getWriter(rangeRes, rangeWriter));
+			rangeWriter->addRange(QVariantList{variantList});
+			QCOMPARE(rangeRes, data);
 		} else if (targetType == QMetaType::QVariantMap ||
 				   targetType == QMetaType::QVariantHash) {
 			const auto variantMap = variantData.toMap();
@@ -349,6 +369,14 @@ void SerializerTest::testVariantConversions()
 			for (auto it = variantMap.begin(), end = variantMap.end(); it != end; ++it)
 				writer->add(it.key(), it.value());
 			QCOMPARE(res, data);
+
+			QVariant emplaceRes{data.userType(), nullptr};
+			ScopedWriter<AssociativeWriter> emplaceWriter;
+			QVERIFY(AssociativeWriter::getWriter(emplaceRes, emplaceWriter));
+			emplaceWriter->reserve(variantMap.size());
+			for (auto it = variantMap.begin(), end = variantMap.end(); it != end; ++it)
+				emplaceWriter->emplace(QVariant{it.key()}, QVariant{it.value()});
+			QCOMPARE(emplaceRes, data);
 		}
 		convData = variantData;
 	} else {
@@ -387,15 +415,28 @@ void SerializerTest::testSerialization()
 			if(works) {
 				auto res = cborSerializer->serialize(data);
 				QCOMPARE(res, cResult);
-			} else
+				// streamed serialization must produce the same data
+				QCOMPARE(QCborValue::fromCbor(cborSerializer->serializeTo(data)), cResult);
+			} else {
 				QVERIFY_EXCEPTION_THROWN(cborSerializer->serialize(data), SerializationException);
+				QVERIFY_EXCEPTION_THROWN(cborSerializer->serializeTo(data), SerializationException);
+			}
 		}
 		if (!jResult.isUndefined()) {
 			if(works) {
 				auto res = jsonSerializer->serialize(data);
 				QCOMPARE(res, jResult);
-			} else
+				// streamed serialization must produce the same data, in both formats
+				if (jResult.isArray() || jResult.isObject()) {
+					const auto jDoc = jResult.isArray() ? QJsonDocument{jResult.toArray()} : QJsonDocument{jResult.toObject()};
+					QCOMPARE(QJsonDocument::fromJson(jsonSerializer->serializeTo(data, QJsonDocument::Compact)), jDoc);
+					QCOMPARE(QJsonDocument::fromJson(jsonSerializer->serializeTo(data, QJsonDocument::Indented)), jDoc);
+				} else
+					QVERIFY_EXCEPTION_THROWN(jsonSerializer->serializeTo(data), SerializationException);
+			} else {
 				QVERIFY_EXCEPTION_THROWN(jsonSerializer->serialize(data), SerializationException);
+				QVERIFY_EXCEPTION_THROWN(jsonSerializer->serializeTo(data), SerializationException);
+			}
 		}
 	} catch(std::exception &e) {
 		QFAIL(e.what());
@@ -748,13 +789,22 @@ void SerializerTest::testDeserialization()
 			if(works) {
 				auto res = cborSerializer->deserialize(cData, result.userType(), this);
 				QCOMPARE(res, result);
-			} else
+				// streamed deserialization must produce the same data
+				QCOMPARE(cborSerializer->deserializeFrom(cData.toCbor(), result.userType(), this), result);
+			} else {
 				QVERIFY_EXCEPTION_THROWN(cborSerializer->deserialize(cData, result.userType(), this), DeserializationException);
+				QVERIFY_EXCEPTION_THROWN(cborSerializer->deserializeFrom(cData.toCbor(), result.userType(), this), DeserializationException);
+			}
 		}
 		if (!jData.isUndefined()) {
 			if(works) {
 				auto res = jsonSerializer->deserialize(jData, result.userType(), this);
 				QCOMPARE(res, result);
+				// streamed deserialization must produce the same data
+				if (jData.isArray())
+					QCOMPARE(jsonSerializer->deserializeFrom(QJsonDocument{jData.toArray()}.toJson(), result.userType(), this), result);
+				else if (jData.isObject())
+					QCOMPARE(jsonSerializer->deserializeFrom(QJsonDocument{jData.toObject()}.toJson(), result.userType(), this), result);
 			} else
 				QVERIFY_EXCEPTION_THROWN(jsonSerializer->deserialize(jData, result.userType(), this), DeserializationException);
 		}
@@ -779,6 +829,7 @@ void SerializerTest::testDeviceSerialization()
 	QCOMPARE(cborSerializer->deserializeFrom<EnumContainer>(cRes), data);
 
 	QCOMPARE(jsonSerializer->serializeTo(data), jRes);
+	QCOMPARE(jsonSerializer->serializeTo(data, QJsonDocument::Indented), QJsonDocument{jMap}.toJson(QJsonDocument::Indented));
 	QCOMPARE(jsonSerializer->deserializeFrom<EnumContainer>(jRes), data);
 
 	// to device
@@ -790,12 +841,615 @@ void SerializerTest::testDeviceSerialization()
 	QCOMPARE(cborSerializer->deserializeFrom<EnumContainer>(&buffer), data);
 	buffer.close();
 
+	// memory mapped
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	QCOMPARE(file.write(cRes), cRes.size());
+	QCOMPARE(file.write(cRes), cRes.size());
+	QVERIFY(file.flush());
+	QVERIFY(file.seek(0));
+	QCOMPARE(cborSerializer->deserializeMapped<EnumContainer>(&file), data);
+	QCOMPARE(file.pos(), cRes.size());
+	QCOMPARE(cborSerializer->deserializeMapped<EnumContainer>(&file), data);
+	QVERIFY(file.atEnd());
+	file.close();
+
+	// byte arrays reference the mapping instead of being copied
+	const QByteArrayList bytesData {"first", QByteArray(300, 'x'), QByteArray{}};
+	const auto bytesRes = cborSerializer->serialize(bytesData).toCbor();
+	QVERIFY(file.open());
+	QVERIFY(file.resize(0));
+	QCOMPARE(file.write(bytesRes), bytesRes.size());
+	QVERIFY(file.flush());
+	QVERIFY(file.seek(0));
+	auto mappedBytes = cborSerializer->deserializeMapped<QByteArrayList>(&file);
+	QCOMPARE(mappedBytes, bytesData);
+	QVERIFY(file.atEnd());
+	// raw data is never owned, so the array has nothing allocated
+	QVERIFY(!mappedBytes[1].data_ptr()->isMutable());
+	// deep copies stay valid once the file is closed
+	const QByteArray bytesCopy{mappedBytes[1].constData(), mappedBytes[1].size()};
+	QVERIFY(bytesCopy.data_ptr()->isMutable());
+	mappedBytes.clear();
+	file.close();
+	QCOMPARE(bytesCopy, bytesData[1]);
+
 	QVERIFY(buffer.open(QIODevice::ReadWrite));
 	jsonSerializer->serializeTo(&buffer, data);
 	QCOMPARE(buffer.data(), jRes);
 	QVERIFY(buffer.seek(0));
 	QCOMPARE(jsonSerializer->deserializeFrom<EnumContainer>(&buffer), data);
 	buffer.close();
+
+	// integers are read exactly, and only whitespace may follow the document
+	const QList<qint64> largeInts {9007199254740993ll, -9007199254740993ll};
+	QCOMPARE(jsonSerializer->deserializeFrom<QList<qint64>>(" [ 9007199254740993, -9007199254740993 ]\n"), largeInts);
+	QVERIFY_EXCEPTION_THROWN(jsonSerializer->deserializeFrom<QList<qint64>>("[1, 2] 3"), DeserializationException);
+	QVERIFY_EXCEPTION_THROWN(jsonSerializer->deserializeFrom<QList<qint64>>("[1, 2"), DeserializationException);
+	QVERIFY_EXCEPTION_THROWN(jsonSerializer->deserializeFrom<QList<qint64>>("42"), DeserializationException);
+
+	// skipped values are validated as well, and only scalars as specified by RFC 8259 are accepted
+	const QList<QByteArray> invalidDocuments {
+		"{\"skipped\": [1}, \"value\": 2}",
+		"{\"skipped\": [1 2], \"value\": 2}",
+		"{\"skipped\": {\"a\" 1}, \"value\": 2}",
+		"{\"skipped\": {1: 1}, \"value\": 2}",
+		"{\"skipped\": nul, \"value\": 2}",
+		"{\"skipped\": 01, \"value\": 2}",
+		"{\"skipped\": \"\x01\", \"value\": 2}",
+		"{\"skipped\": \"\xC0\xAF\", \"value\": 2}",
+		"{\"skipped\": \"\\uD800\", \"value\": 2}",
+		"{\"value\": -02}",
+		"{\"skipped\": \"\\uDC00\", \"value\": 2}"
+	};
+	for (const auto &document : invalidDocuments)
+		QVERIFY_EXCEPTION_THROWN(jsonSerializer->deserializeAt<int>(document, QStringLiteral("/value")), DeserializationException);
+	QCOMPARE(jsonSerializer->deserializeAt<QString>("{\"skipped\": [{\"a\": \"\\uD83D\\uDE00\"}, 0, -0.5e1], \"value\": \"\\uD83D\\uDE00\xC3\xA4\"}", QStringLiteral("/value")),
+			 QStringLiteral("\U0001F600\u00E4"));
+
+	// integer literals are still valid for doubles and enums
+	const QList<double> doubles {1, 2.5, -3};
+	const QList<QLocale::Language> languages {QLocale::German, QLocale::English};
+	buffer.setData({});
+	QVERIFY(buffer.open(QIODevice::ReadWrite));
+	jsonSerializer->serializeTo(&buffer, doubles);
+	QVERIFY(buffer.seek(0));
+	QCOMPARE(jsonSerializer->deserializeFrom<QList<double>>(&buffer), doubles);
+	buffer.close();
+	buffer.setData({});
+	QVERIFY(buffer.open(QIODevice::ReadWrite));
+	jsonSerializer->serializeTo(&buffer, languages);
+	QVERIFY(buffer.seek(0));
+	QCOMPARE(jsonSerializer->deserializeFrom<QList<QLocale::Language>>(&buffer), languages);
+	buffer.close();
+}
+
+void SerializerTest::testJsonLines()
+{
+	const auto [record1, record2] = testRecords();
+
+	QBuffer buffer;
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	try {
+		JsonLinesWriter writer{jsonSerializer, &buffer};
+		writer.write(record1);
+		// a record that fails halfway is dropped completely
+		const QList<EnumContainer> invalidRecord {record2, {EnumContainer::Normal0, EnumContainer::Flag1}};
+		QVERIFY_EXCEPTION_THROWN(writer.write(invalidRecord), SerializationException);
+		writer.write(record2);
+		writer.write(42);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	buffer.close();
+
+	const auto lines = buffer.data().split('\n');
+	QCOMPARE(lines.size(), 4);
+	QCOMPARE(lines[0], jsonSerializer->serializeTo(record1));
+	QCOMPARE(lines[1], jsonSerializer->serializeTo(record2));
+	QCOMPARE(lines[2], QByteArray{"42"});
+	QVERIFY(lines[3].isEmpty());
+
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	try {
+		JsonLinesReader reader{jsonSerializer, &buffer};
+		QVERIFY(reader.hasNext());
+		QCOMPARE(reader.read<EnumContainer>(), record1);
+		QVERIFY(reader.hasNext());
+		QCOMPARE(reader.read<EnumContainer>(), record2);
+		QVERIFY(reader.hasNext());
+		QCOMPARE(reader.read<int>(), 42);
+		QVERIFY(!reader.hasNext());
+		QVERIFY_EXCEPTION_THROWN(reader.read<int>(), DeserializationException);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	buffer.close();
+
+	// records larger than the chunks the device is read in
+	QList<int> largeRecord;
+	for (auto i = 0; i < 100000; ++i)
+		largeRecord.append(i);
+	buffer.setData(jsonSerializer->serializeTo(largeRecord) + "\n42\n");
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	try {
+		JsonLinesReader reader{jsonSerializer, &buffer};
+		QCOMPARE(reader.read<QList<int>>(), largeRecord);
+		QCOMPARE(reader.read<int>(), 42);
+		QVERIFY(!reader.hasNext());
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	buffer.close();
+
+	// records must be separated by a newline
+	buffer.setData(jsonSerializer->serializeTo(record1) + " " + jsonSerializer->serializeTo(record2) + "\n");
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	try {
+		JsonLinesReader reader{jsonSerializer, &buffer};
+		QCOMPARE(reader.read<EnumContainer>(), record1);
+		QVERIFY_EXCEPTION_THROWN(reader.read<EnumContainer>(), DeserializationException);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	buffer.close();
+}
+
+void SerializerTest::testCborSequence()
+{
+	const auto [record1, record2] = testRecords();
+
+	QBuffer buffer;
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	try {
+		CborSequenceWriter writer{cborSerializer, &buffer};
+		writer.write(record1);
+		writer.write(QStringLiteral("invalid"));
+		writer.write(record2);
+		writer.write(42);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	buffer.close();
+
+	// records are concatenated without any framing
+	QCOMPARE(buffer.data(), cborSerializer->serializeTo(record1) +
+							cborSerializer->serializeTo(QStringLiteral("invalid")) +
+							cborSerializer->serializeTo(record2) +
+							cborSerializer->serializeTo(42));
+
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	try {
+		CborSequenceReader reader{cborSerializer, &buffer};
+		QVERIFY(reader.hasNext());
+		QCOMPARE(reader.read<EnumContainer>(), record1);
+		QVERIFY(reader.hasNext());
+		QVERIFY_EXCEPTION_THROWN(reader.read<EnumContainer>(), DeserializationException);
+		QVERIFY(reader.hasNext());
+		QCOMPARE(reader.read<EnumContainer>(), record2);
+		QVERIFY(reader.hasNext());
+		QCOMPARE(reader.read<int>(), 42);
+		QVERIFY(!reader.hasNext());
+		QVERIFY_EXCEPTION_THROWN(reader.read<int>(), DeserializationException);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	buffer.close();
+
+	// records larger than the chunks the device is read in
+	QList<int> largeRecord;
+	for (auto i = 0; i < 100000; ++i)
+		largeRecord.append(i);
+	buffer.setData(cborSerializer->serializeTo(largeRecord) + cborSerializer->serializeTo(42));
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	try {
+		CborSequenceReader reader{cborSerializer, &buffer};
+		QCOMPARE(reader.read<QList<int>>(), largeRecord);
+		QCOMPARE(reader.read<int>(), 42);
+		QVERIFY(!reader.hasNext());
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	buffer.close();
+}
+
+void SerializerTest::testSequenceSerialization()
+{
+	const QList<QList<int>> rows {
+		{1, 2, 3},
+		{},
+		{4, 5}
+	};
+
+	try {
+		// generator source
+		auto index = 0;
+		const auto generator = [&]() -> std::optional<QList<int>> {
+			if (index < rows.size())
+				return rows[index++];
+			else
+				return std::nullopt;
+		};
+
+		QBuffer jsonBuffer;
+		QVERIFY(jsonBuffer.open(QIODevice::WriteOnly));
+		jsonSerializer->serializeSequenceTo<QList<int>>(&jsonBuffer, generator);
+		jsonBuffer.close();
+		QCOMPARE(index, rows.size());
+		QCOMPARE(jsonBuffer.data(), jsonSerializer->serializeTo(rows));
+
+		index = 0;
+		QBuffer cborBuffer;
+		QVERIFY(cborBuffer.open(QIODevice::WriteOnly));
+		cborSerializer->serializeSequenceTo<QList<int>>(&cborBuffer, generator);
+		cborBuffer.close();
+		QCOMPARE(index, rows.size());
+		// the array has an indefinite length, as the number of elements is unknown
+		QCOMPARE(static_cast<quint8>(cborBuffer.data().at(0)), static_cast<quint8>(0x9F));
+		QCOMPARE(cborSerializer->deserializeFrom<QList<QList<int>>>(cborBuffer.data()), rows);
+
+		// iterator source
+		jsonBuffer.setData({});
+		QVERIFY(jsonBuffer.open(QIODevice::WriteOnly));
+		jsonSerializer->serializeSequenceTo(&jsonBuffer, rows.constBegin(), rows.constEnd(), QJsonDocument::Indented);
+		jsonBuffer.close();
+		QCOMPARE(jsonBuffer.data(), jsonSerializer->serializeTo(rows, QJsonDocument::Indented));
+
+		cborBuffer.setData({});
+		QVERIFY(cborBuffer.open(QIODevice::WriteOnly));
+		cborSerializer->serializeSequenceTo(&cborBuffer, rows.constBegin(), rows.constEnd());
+		cborBuffer.close();
+		QCOMPARE(cborSerializer->deserializeFrom<QList<QList<int>>>(cborBuffer.data()), rows);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+}
+
+void SerializerTest::testPartialDeserialization()
+{
+	const EnumContainer record{EnumContainer::Normal1, EnumContainer::Flag1 | EnumContainer::Flag3};
+	const auto document = [&](const QCborValue &recordValue) {
+		return QCborMap{
+			{QStringLiteral("header"), QCborMap{
+				 {QStringLiteral("id"), 5},
+				 {QStringLiteral("routing"), QCborMap{
+					  {QStringLiteral("key"), QStringLiteral("}]")},
+					  {QStringLiteral("flags"), QCborArray{1, 2}}
+				  }}
+			 }},
+			{QStringLiteral("body"), QCborArray{
+				 QStringLiteral("x\"y"),
+				 QCborMap{{QStringLiteral("a"), QCborArray{1, QCborMap{{QStringLiteral("b"), QStringLiteral("]")}}}}},
+				 3.5,
+				 true,
+				 QCborValue::Null
+			 }},
+			{QStringLiteral("record"), recordValue},
+			{QStringLiteral("a/b"), 7},
+			{QStringLiteral("m~n"), 8}
+		};
+	};
+
+	const auto check = [&](auto serializer, const QByteArray &data) {
+		try {
+			QCOMPARE(serializer->template deserializeAt<int>(data, QStringLiteral("/header/id")), 5);
+			QCOMPARE(serializer->template deserializeAt<QList<int>>(data, QStringLiteral("/header/routing/flags")), QList<int>({1, 2}));
+			QCOMPARE(serializer->template deserializeAt<QString>(data, QStringLiteral("/body/0")), QStringLiteral("x\"y"));
+			QCOMPARE(serializer->template deserializeAt<double>(data, QStringLiteral("/body/2")), 3.5);
+			QCOMPARE(serializer->template deserializeAt<bool>(data, QStringLiteral("/body/3")), true);
+			QCOMPARE(serializer->template deserializeAt<EnumContainer>(data, QStringLiteral("/record")), record);
+			QCOMPARE(serializer->template deserializeAt<int>(data, QStringLiteral("/a~1b")), 7);
+			QCOMPARE(serializer->template deserializeAt<int>(data, QStringLiteral("/m~0n")), 8);
+		} catch(std::exception &e) {
+			QFAIL(e.what());
+		}
+
+		QVERIFY_EXCEPTION_THROWN(serializer->template deserializeAt<int>(data, QStringLiteral("/header/missing")), DeserializationException);
+		QVERIFY_EXCEPTION_THROWN(serializer->template deserializeAt<int>(data, QStringLiteral("/body/9")), DeserializationException);
+		QVERIFY_EXCEPTION_THROWN(serializer->template deserializeAt<int>(data, QStringLiteral("/body/01")), DeserializationException);
+		QVERIFY_EXCEPTION_THROWN(serializer->template deserializeAt<int>(data, QStringLiteral("/header/id/0")), DeserializationException);
+		QVERIFY_EXCEPTION_THROWN(serializer->template deserializeAt<int>(data, QStringLiteral("header")), DeserializationException);
+		QVERIFY_EXCEPTION_THROWN(serializer->template deserializeAt<int>(data, QStringLiteral("/m~2n")), DeserializationException);
+	};
+
+	check(jsonSerializer, QJsonDocument{document(QCborValue::fromJsonValue(jsonSerializer->serialize(record))).toJsonObject()}.toJson(QJsonDocument::Indented));
+	check(cborSerializer, document(cborSerializer->serialize(record)).toCbor());
+}
+
+void SerializerTest::testStaticPath()
+{
+	const QList<int> intList {1, -2, 3};
+	const QVector<double> doubleVector {0.5, -4.2};
+	const QStringList stringList {QStringLiteral("a"), QString{}};
+	const qint64 largeInt = std::numeric_limits<qint64>::max();
+
+	resetProps();
+	try {
+		// the static path must produce exactly what the variant engine does
+		QCOMPARE(cborSerializer->serialize(intList), cborSerializer->serialize(QVariant::fromValue(intList)));
+		QCOMPARE(cborSerializer->serialize(doubleVector), cborSerializer->serialize(QVariant::fromValue(doubleVector)));
+		QCOMPARE(cborSerializer->serialize(stringList), cborSerializer->serialize(QVariant::fromValue(stringList)));
+		QCOMPARE(cborSerializer->serialize(largeInt), cborSerializer->serialize(QVariant::fromValue(largeInt)));
+		QCOMPARE(cborSerializer->serialize(true), cborSerializer->serialize(QVariant{true}));
+		QCOMPARE(QJsonValue{jsonSerializer->serialize(intList)}, jsonSerializer->serialize(QVariant::fromValue(intList)));
+		QCOMPARE(QJsonValue{jsonSerializer->serialize(doubleVector)}, jsonSerializer->serialize(QVariant::fromValue(doubleVector)));
+		QCOMPARE(QJsonValue{jsonSerializer->serialize(stringList)}, jsonSerializer->serialize(QVariant::fromValue(stringList)));
+
+		QCOMPARE(cborSerializer->deserialize<QList<int>>(cborSerializer->serialize(intList)), intList);
+		QCOMPARE(cborSerializer->deserialize<QVector<double>>(cborSerializer->serialize(doubleVector)), doubleVector);
+		QCOMPARE(cborSerializer->deserialize<QStringList>(cborSerializer->serialize(stringList)), stringList);
+		QCOMPARE(cborSerializer->deserialize<qint64>(cborSerializer->serialize(largeInt)), largeInt);
+		QCOMPARE(jsonSerializer->deserialize<QList<int>>(jsonSerializer->serialize(intList)), intList);
+		QCOMPARE(jsonSerializer->deserialize<QStringList>(jsonSerializer->serialize(stringList)), stringList);
+
+		// tags customize the result, so the variant engine is used instead
+		cborSerializer->setTypeTag<int>(static_cast<QCborTag>(CborSerializer::Identifier));
+		QCOMPARE(cborSerializer->serialize(42), QCborValue(static_cast<QCborTag>(CborSerializer::Identifier), 42));
+		QCOMPARE(cborSerializer->serialize(intList), cborSerializer->serialize(QVariant::fromValue(intList)));
+		cborSerializer->setTypeTag<int>();
+
+		// the memoized decision follows changed settings
+		cborSerializer->setTypedArrays(true);
+		QVERIFY(cborSerializer->serialize(intList).isTag());
+		QCOMPARE(cborSerializer->serialize(stringList), cborSerializer->serialize(QVariant::fromValue(stringList)));
+		cborSerializer->setTypedArrays(false);
+		QCOMPARE(cborSerializer->serialize(intList), QCborValue{QCborArray{1, -2, 3}});
+	} catch(std::exception &e) {
+		cborSerializer->setTypeTag<int>();
+		cborSerializer->setTypedArrays(false);
+		QFAIL(e.what());
+	}
+
+	// values the static path cannot handle are still validated by the variant engine
+	QVERIFY_EXCEPTION_THROWN(cborSerializer->deserialize<QList<int>>(QCborArray{1, 2.5}), DeserializationException);
+}
+
+void SerializerTest::testDeserializeInto()
+{
+	// EnumContainer is handled by TestWrapperConverter, so a plain gadget is used to reach the GadgetConverter
+	const TestGadget record{42, QStringLiteral("record")};
+	const TestGadget initial{1, QStringLiteral("initial")};
+
+	resetProps();
+	try {
+		// gadgets are read from and written to directly
+		QCOMPARE(cborSerializer->serialize(record), QCborValue{QCborMap{
+			{QStringLiteral("id"), 42},
+			{QStringLiteral("name"), QStringLiteral("record")}
+		}});
+		QCOMPARE(cborSerializer->serialize(record), cborSerializer->serialize(QVariant::fromValue(record)));
+		QCOMPARE(QJsonValue{jsonSerializer->serialize(record)}, jsonSerializer->serialize(QVariant::fromValue(record)));
+
+		auto target = initial;
+		cborSerializer->deserializeInto(cborSerializer->serialize(record), target);
+		QCOMPARE(target, record);
+		target = initial;
+		jsonSerializer->deserializeInto(jsonSerializer->serialize(record), target);
+		QCOMPARE(target, record);
+
+		// properties that are not part of the data keep their values
+		auto partialData = cborSerializer->serialize(record).toMap();
+		QVERIFY(partialData.contains(QStringLiteral("name")));
+		partialData.remove(QStringLiteral("name"));
+		target = initial;
+		cborSerializer->deserializeInto(partialData, target);
+		QCOMPARE(target.id, 42);
+		QCOMPARE(target.name, QStringLiteral("initial"));
+
+		auto partialJson = jsonSerializer->serialize(record);
+		partialJson.remove(QStringLiteral("id"));
+		target = initial;
+		jsonSerializer->deserializeInto(partialJson, target);
+		QCOMPARE(target.id, 1);
+		QCOMPARE(target.name, QStringLiteral("record"));
+
+		// all other types are assigned
+		QList<int> list {9};
+		cborSerializer->deserializeInto(QCborArray{1, 2}, list);
+		QCOMPARE(list, QList<int>({1, 2}));
+		QVariant variant {QStringLiteral("old")};
+		cborSerializer->deserializeInto(QCborValue{42}, variant);
+		QCOMPARE(variant.toInt(), 42);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+}
+
+void SerializerTest::testContainerReaders()
+{
+	const QList<QList<int>> list {{1, 2}, {3}};
+	const QMap<QString, QMap<QString, int>> map {
+		{QStringLiteral("a"), {{QStringLiteral("x"), 1}}},
+		{QStringLiteral("b"), {}}
+	};
+
+	// the registration functions add readers next to the writers
+	const auto listVariant = QVariant::fromValue(list);
+	ScopedReader<SequentialReader> listReader;
+	QVERIFY(SequentialReader::getReader(listVariant, listReader));
+	QCOMPARE(listReader->info().type, qMetaTypeId<QList<int>>());
+	QCOMPARE(listReader->size(), 2);
+	QList<const void*> elements;
+	listReader->forEach([&](const void *element) {
+		elements.append(element);
+	});
+	QCOMPARE(elements, QList<const void*>({&list[0], &list[1]}));
+
+	const auto mapVariant = QVariant::fromValue(map);
+	ScopedReader<AssociativeReader> mapReader;
+	QVERIFY(AssociativeReader::getReader(mapVariant, mapReader));
+	QCOMPARE(mapReader->info().keyType, static_cast<int>(QMetaType::QString));
+	QCOMPARE(mapReader->info().valueType, qMetaTypeId<QMap<QString, int>>());
+	QCOMPARE(mapReader->size(), 2);
+	QVERIFY(!AssociativeReader::canRead(qMetaTypeId<QPair<int, int>>()));
+
+	const QVariant variantList{QVariantList{1, true}};
+	ScopedReader<SequentialReader> variantReader;
+	QVERIFY(SequentialReader::getReader(variantList, variantReader));
+	QCOMPARE(variantReader->info().type, static_cast<int>(QMetaType::UnknownType));
+
+	// read containers serialize the same as before
+	resetProps();
+	try {
+		QCOMPARE(cborSerializer->serialize(list), QCborValue{QCborArray{QCborArray{1, 2}, QCborArray{3}}});
+		QCOMPARE(QCborValue::fromCbor(cborSerializer->serializeTo(list)), QCborValue{QCborArray{QCborArray{1, 2}, QCborArray{3}}});
+		QCOMPARE(jsonSerializer->serialize(map), QJsonObject({
+			{QStringLiteral("a"), QJsonObject{{QStringLiteral("x"), 1}}},
+			{QStringLiteral("b"), QJsonObject{}}
+		}));
+		QCOMPARE(QJsonDocument::fromJson(jsonSerializer->serializeTo(map)).object(),
+				 jsonSerializer->serialize(map));
+		QCOMPARE(cborSerializer->serialize(QVariantList{1, true}), QCborValue{QCborArray{1, true}});
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+}
+
+void SerializerTest::testKeyCollisions()
+{
+	// keys that only become equal when serialized must be written once, with the last value
+	const auto base = QDateTime::fromSecsSinceEpoch(1000000, Qt::UTC);
+	const QMap<QDateTime, int> map {
+		{base, 1},
+		{base.addMSecs(500), 2}
+	};
+	QMultiMap<QDateTime, int> multiMap;
+	multiMap.insert(base, 1);
+	multiMap.insert(base.addMSecs(500), 2);
+	multiMap.insert(base.addSecs(1), 3);
+
+	cborSerializer->setDateAsTimeStamp(true);
+	jsonSerializer->setDateAsTimeStamp(true);
+	try {
+		const auto key1 = cborSerializer->serialize(base);
+		const auto key2 = cborSerializer->serialize(base.addSecs(1));
+
+		const QCborValue cMap{QCborMap{{key1, 2}}};
+		QCOMPARE(cborSerializer->serialize(map), cMap);
+		QCOMPARE(QCborValue::fromCbor(cborSerializer->serializeTo(map)), cMap);
+		const auto jMap = jsonSerializer->serialize(map);
+		QCOMPARE(jMap.size(), 1);
+		QCOMPARE(jsonSerializer->serializeTo(map), QJsonDocument{jMap}.toJson(QJsonDocument::Compact));
+
+		// the values of colliding multi map keys are merged
+		const QCborValue cMultiMap{static_cast<QCborTag>(CborSerializer::MultiMap), QCborMap{
+			{key1, QCborArray{1, 2}},
+			{key2, QCborArray{3}}
+		}};
+		QCOMPARE(cborSerializer->serialize(multiMap), cMultiMap);
+		QCOMPARE(QCborValue::fromCbor(cborSerializer->serializeTo(multiMap)), cMultiMap);
+
+		// large maps are built differently, but must keep the order and the last of equal keys
+		QMap<QDateTime, int> largeMap;
+		QCborMap cLargeMap;
+		for (auto i = 0; i < 80; ++i) {
+			largeMap.insert(base.addMSecs(i * 500), i);
+			cLargeMap.insert(cborSerializer->serialize(base.addSecs(i / 2)), i - i % 2 + 1);
+		}
+		QCOMPARE(cLargeMap.size(), 40);
+		QCOMPARE(cborSerializer->serialize(largeMap), QCborValue{cLargeMap});
+		QCOMPARE(QCborValue::fromCbor(cborSerializer->serializeTo(largeMap)), QCborValue{cLargeMap});
+
+		QMap<QString, QMap<QString, int>> nestedMap;
+		QCborMap cNestedMap;
+		for (auto i = 0; i < 40; ++i) {
+			const auto key = QStringLiteral("key%1").arg(i, 2, 10, QLatin1Char('0'));
+			QCborMap cInner;
+			for (auto j = 0; j < 40; ++j) {
+				const auto innerKey = QStringLiteral("inner%1").arg(j, 2, 10, QLatin1Char('0'));
+				nestedMap[key].insert(innerKey, i * j);
+				cInner.insert(innerKey, i * j);
+			}
+			cNestedMap.insert(key, cInner);
+		}
+		QCOMPARE(cborSerializer->serialize(nestedMap), QCborValue{cNestedMap});
+		QCOMPARE(cborSerializer->deserializeFrom<decltype(nestedMap)>(cborSerializer->serializeTo(nestedMap)), nestedMap);
+		QCOMPARE(cborSerializer->deserializeFrom<QCborMap>(cborSerializer->serializeTo(nestedMap)), cNestedMap);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
+	resetProps();
+}
+
+void SerializerTest::testIncrementalDeserialization()
+{
+	const auto [record1, record2] = testRecords();
+
+	const std::initializer_list<std::pair<SerializerBase*, QByteArray>> streams {
+		{jsonSerializer, jsonSerializer->serializeTo(record1) + " \n" + jsonSerializer->serializeTo(record2)},
+		{cborSerializer, cborSerializer->serializeTo(record1) + cborSerializer->serializeTo(record2)}
+	};
+	for (const auto &stream : streams) {
+		IncrementalDeserializer deserializer{stream.first, qMetaTypeId<EnumContainer>()};
+		QVariantList results;
+		connect(&deserializer, &IncrementalDeserializer::valueDeserialized,
+				this, [&](const QVariant &value) {
+					results.append(value);
+				});
+
+		try {
+			// feed the data byte by byte, to split the values everywhere
+			for (const auto byte : stream.second)
+				deserializer.addData(QByteArray{1, byte});
+		} catch(std::exception &e) {
+			QFAIL(e.what());
+		}
+		QVERIFY(!deserializer.hasPendingData());
+		QCOMPARE(results.size(), 2);
+		QCOMPARE(results[0].value<EnumContainer>(), record1);
+		QCOMPARE(results[1].value<EnumContainer>(), record2);
+	}
+
+	// invalid values are reported and skipped, and the values behind them are still deserialized
+	const std::initializer_list<std::tuple<SerializerBase*, QByteArray, QByteArray>> invalidStreams {
+		{jsonSerializer, jsonSerializer->serializeTo(record1) + "[1]" + jsonSerializer->serializeTo(record2), "x"},
+		{cborSerializer, cborSerializer->serializeTo(record1) + QCborValue{QCborArray{1}}.toCbor() + cborSerializer->serializeTo(record2), "\xFF"}
+	};
+	for (const auto &[serializer, data, malformedData] : invalidStreams) {
+		IncrementalDeserializer deserializer{serializer, qMetaTypeId<EnumContainer>()};
+		QVariantList results;
+		QStringList errors;
+		connect(&deserializer, &IncrementalDeserializer::valueDeserialized,
+				this, [&](const QVariant &value) {
+					results.append(value);
+				});
+		connect(&deserializer, &IncrementalDeserializer::errorOccurred,
+				this, [&](const QString &error) {
+					errors.append(error);
+				});
+
+		deserializer.addData(data);
+		QCOMPARE(errors.size(), 1);
+		QCOMPARE(results.size(), 2);
+		QCOMPARE(results[1].value<EnumContainer>(), record2);
+		QVERIFY(!deserializer.hasFailed());
+
+		// malformed data cannot be skipped, so everything is ignored until cleared
+		deserializer.addData(malformedData);
+		QCOMPARE(errors.size(), 2);
+		QVERIFY(deserializer.hasFailed());
+		deserializer.addData(data);
+		QCOMPARE(results.size(), 2);
+		deserializer.clear();
+		QVERIFY(!deserializer.hasFailed());
+		deserializer.addData(data);
+		QCOMPARE(errors.size(), 3);
+		QCOMPARE(results.size(), 4);
+	}
+
+	// deserialized objects get the value parent
+	IncrementalDeserializer deserializer{jsonSerializer, qMetaTypeId<TestObject*>()};
+	deserializer.setValueParent(this);
+	QCOMPARE(deserializer.valueParent(), this);
+	TestObject *object = nullptr;
+	connect(&deserializer, &IncrementalDeserializer::valueDeserialized,
+			this, [&](const QVariant &value) {
+				object = value.value<TestObject*>();
+			});
+	deserializer.addData("{}");
+	QVERIFY(object);
+	QCOMPARE(object->parent(), this);
+	delete object;
 }
 
 void SerializerTest::testExceptionTrace()
@@ -813,6 +1467,15 @@ void SerializerTest::testExceptionTrace()
 	}
 }
 
+std::pair<EnumContainer, EnumContainer> SerializerTest::testRecords()
+{
+	// two distinct records, for the tests of the record based readers and writers
+	return {
+		{EnumContainer::Normal1, EnumContainer::Flag1 | EnumContainer::Flag3},
+		{EnumContainer::Normal2, EnumContainer::Flag2}
+	};
+}
+
 void SerializerTest::addCommonData()
 {
 	// basic types without any converter
@@ -947,6 +1610,7 @@ void SerializerTest::resetProps()
 		ser->setKeepObjectName(false);
 		ser->setEnumAsString(false);
 		ser->setVersionAsString(false);
+		ser->setDateAsTimeStamp(false);
 		ser->setUseBcp47Locale(true);
 		ser->setValidationFlags(JsonSerializer::ValidationFlag::StrictBasicTypes);
 		ser->setPolymorphing(JsonSerializer::Polymorphing::Enabled);
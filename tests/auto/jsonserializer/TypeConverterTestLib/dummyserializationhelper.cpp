@@ -2,6 +2,7 @@
 #include <QtTest>
 #include <QtJsonSerializer/exception.h>
 #include <QtJsonSerializer/CborSerializer>
+#include <QtJsonSerializer/JsonSerializer>
 
 #include <QtJsonSerializer/private/serializerbase_p.h>
 #include <QtJsonSerializer/private/exceptioncontext_p.h>
@@ -21,6 +22,30 @@ QVariant DummySerializationHelper::getProperty(const char *name) const
 	return properties.value(QString::fromUtf8(name));
 }
 
+QSharedPointer<const SerializerSettings> DummySerializationHelper::settings() const
+{
+	// rebuilt on every call, as the tests modify the properties between calls
+	auto settings = QSharedPointer<SerializerSettings>::create();
+	const auto value = [this](const char *name, auto &target) {
+		target = getProperty(name).value<std::decay_t<decltype(target)>>();
+	};
+
+	value("allowDefaultNull", settings->allowDefaultNull);
+	value("keepObjectName", settings->keepObjectName);
+	value("enumAsString", settings->enumAsString);
+	value("versionAsString", settings->versionAsString);
+	value("dateAsTimeStamp", settings->dateAsTimeStamp);
+	value("useBcp47Locale", settings->useBcp47Locale);
+	value("validationFlags", settings->validationFlags);
+	value("polymorphing", settings->polymorphing);
+	value("multiMapMode", settings->multiMapMode);
+	value("ignoreStoredAttribute", settings->ignoreStoredAttribute);
+	settings->byteArrayFormat = static_cast<int>(getProperty("byteArrayFormat").value<JsonSerializer::ByteArrayFormat>());
+	value("validateBase64", settings->validateBase64);
+	value("typedArrays", settings->typedArrays);
+	return settings;
+}
+
 QCborTag DummySerializationHelper::typeTag(int metaTypeId) const
 {
 	Q_UNUSED(metaTypeId)
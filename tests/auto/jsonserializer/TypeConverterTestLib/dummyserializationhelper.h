@@ -4,6 +4,7 @@
 #include <QtCore/QQueue>
 #include <QtCore/QHash>
 #include <QtJsonSerializer/TypeConverter>
+#include <QtJsonSerializer/SerializerBase>
 
 class DummySerializationHelper : public QObject, public QtJsonSerializer::TypeConverter::SerializationHelper
 {
@@ -14,6 +15,7 @@ public:
 
 	bool jsonMode() const override;
 	QVariant getProperty(const char *name) const override;
+	QSharedPointer<const QtJsonSerializer::SerializerSettings> settings() const override;
 	QCborTag typeTag(int metaTypeId) const override;
 	QSharedPointer<const QtJsonSerializer::TypeExtractor> extractor(int metaTypeId) const override;
 	QCborValue serializeSubtype(const QMetaProperty &property, const QVariant &value) const override;